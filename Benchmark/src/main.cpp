@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <Logger.h>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+constexpr std::size_t c_Records = 200'000;
+
+// Times logging c_Records records, including the logger draining its queue on destruction.
+static auto Measure(const std::string_view name, const std::function<lgx::Logger()>& makeLogger) -> void
+{
+    const auto start = std::chrono::steady_clock::now();
+    {
+        const auto logger = makeLogger();
+        for (std::size_t i = 0; i < c_Records; ++i)
+            logger.Info("Record #{} with a payload of {} and {}", i, 3.14159, "some text");
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fmt::print("{:<24} {:>10.3f} ms {:>12.0f} records/s\n", name, elapsed * 1000.0, c_Records / elapsed);
+}
+
+// Times only the calling thread's side of c_Records log calls (formatting and queueing), which is the part the
+// LGX_HEADER_ONLY and IPO builds can inline.
+template <typename TLog>
+static auto MeasureCalls(const std::string_view name, TLog&& log) -> void
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < c_Records; ++i)
+        log(i);
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fmt::print("{:<24} {:>10.1f} ns/call\n", name, elapsed * 1e9 / c_Records);
+}
+
+// Aggregate throughput of 1 up to every hardware thread logging c_Records records between them into one logger,
+// including the drain on destruction.
+static auto MeasureScaling() -> void
+{
+    std::ostream   null_stream{ nullptr };
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned thread_count = 1;; thread_count = std::min(thread_count * 2, max_threads))
+    {
+        const auto start = std::chrono::steady_clock::now();
+        {
+            const auto logger = lgx::Logger{ lgx::Logger::Properties{ .outputStreams = { &null_stream } } };
+
+            std::vector<std::thread> threads;
+            for (unsigned t = 0; t < thread_count; ++t)
+            {
+                threads.emplace_back(
+                    [&, t]()
+                    {
+                        for (std::size_t i = t; i < c_Records; i += thread_count)
+                            logger.Info("Record #{} from thread {}", i, t);
+                    });
+            }
+            for (auto& thread : threads)
+                thread.join();
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        fmt::print("{:<24} {:>10.3f} ms {:>12.0f} records/s\n", fmt::format("{} thread(s)", thread_count),
+                   elapsed * 1000.0, c_Records / elapsed);
+
+        if (thread_count == max_threads)
+            break;
+    }
+}
+
+auto main() -> int
+{
+    const lgx::Logger::DefaultStyle style = { .format = "[{datetime}] [{level}] ({prefix}): {msg}" };
+
+    auto fs = std::ofstream("./bench_ofstream.log");
+    Measure("std::ofstream", [&]() {
+        return lgx::Logger{ lgx::Logger::Properties{ .outputStreams = { &fs }, .defaultStyle = style } };
+    });
+
+#ifdef __unix__
+    const int fd = open("./bench_fd.log", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    Measure("fd (batched)", [&]() {
+        return lgx::Logger{
+            lgx::Logger::Properties{ .outputStreams = {}, .outputFds = { fd }, .defaultStyle = style }
+        };
+    });
+    close(fd);
+#endif
+
+    // Nothing is written, so the poll thread stays cheap and the calls themselves are measured.
+    std::ostream null_stream{ nullptr };
+    lgx::GetGlobal().SetOutputStreams({ &null_stream });
+    MeasureCalls("lgx::Log", [](const std::size_t i) { lgx::Log(lgx::Info, "Record #{} with {}", i, 3.14159); });
+
+    const auto logger = lgx::Logger{ lgx::Logger::Properties{ .outputStreams = { &null_stream } } };
+    MeasureCalls("Logger::Info", [&](const std::size_t i) { logger.Info("Record #{} with {}", i, 3.14159); });
+
+    MeasureScaling();
+}
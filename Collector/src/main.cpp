@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+#include <Logger.h>
+
+// Drains the shared memory rings of every worker logging with Properties::sharedRing set to the same name and
+// writes them out through a regular logger, so all file and syslog I/O for the host happens in this process.
+
+static std::atomic<bool> g_Running = true;
+
+static void OnStop(int)
+{
+    g_Running = false;
+}
+
+static auto PrintUsage() -> void
+{
+    std::cerr << "Usage: logex-collector [--ring=<name>] [--file=<path>] [--format=<format>] [--syslog] [--verbose] "
+                 "[--quiet]\n"
+                 "  --ring     Ring name the workers use (default: Logex).\n"
+                 "  --file     Also append records to this file.\n"
+                 "  --format   Line format, e.g. \"[{datetime}] ({prefix}) {context}: {msg}\".\n"
+                 "  --syslog   Also forward records to syslog.\n"
+                 "  --verbose  Write Verbose records too.\n"
+                 "  --quiet    Do not write to stdout.\n";
+}
+
+auto main(int argc, char** argv) -> int
+{
+    std::string ring = "Logex";
+    std::string file_path;
+    std::string format  = lgx::Logger::DefaultStyle{}.format;
+    bool        syslog  = false;
+    bool        verbose = false;
+    bool        quiet   = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg.starts_with("--ring="))
+            ring = arg.substr(sizeof("--ring=") - 1);
+        else if (arg.starts_with("--file="))
+            file_path = arg.substr(sizeof("--file=") - 1);
+        else if (arg.starts_with("--format="))
+            format = arg.substr(sizeof("--format=") - 1);
+        else if (arg == "--syslog")
+            syslog = true;
+        else if (arg == "--verbose")
+            verbose = true;
+        else if (arg == "--quiet")
+            quiet = true;
+        else
+        {
+            PrintUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::ofstream              file;
+    std::vector<std::ostream*> streams;
+    if (!quiet)
+        streams.push_back(&std::cout);
+    if (!file_path.empty())
+    {
+        file.open(file_path, std::ios::app);
+        if (!file)
+        {
+            std::cerr << "logex-collector: cannot open " << file_path << '\n';
+            return 1;
+        }
+        streams.push_back(&file);
+    }
+
+    std::signal(SIGINT, OnStop);
+    std::signal(SIGTERM, OnStop);
+
+    auto collector = std::make_unique<lgx::Logger>(lgx::Logger::Properties{ .loggerName    = ring,
+                                                                            .outputStreams = std::move(streams),
+                                                                            .verbose       = verbose,
+                                                                            .level         = lgx::Level::Debug,
+                                                                            .syslog        = syslog,
+                                                                            .defaultStyle  = { .format = format } });
+
+    std::vector<std::unique_ptr<lgx::SharedRingReader>> readers;
+    std::vector<lgx::shm::Record>                       records;
+    auto last_discovery = std::chrono::steady_clock::time_point{};
+    auto idle_sleep     = std::chrono::microseconds{ 100 };
+
+    while (true)
+    {
+        const bool stopping = !g_Running;
+        const auto now      = std::chrono::steady_clock::now();
+        if (now - last_discovery > std::chrono::milliseconds{ 250 })
+        {
+            last_discovery = now;
+            for (auto& name : lgx::SharedRingReader::Discover(ring))
+            {
+                const auto known = std::any_of(readers.begin(), readers.end(),
+                                               [&](const auto& reader) { return reader->GetName() == name; });
+                if (known)
+                    continue;
+
+                auto reader = std::make_unique<lgx::SharedRingReader>(std::move(name));
+                if (reader->IsOpen())
+                    readers.push_back(std::move(reader));
+            }
+        }
+
+        // Check before draining so nothing a finished writer committed can be missed.
+        std::vector<bool> gone(readers.size());
+        for (std::size_t i = 0; i < readers.size(); ++i)
+            gone[i] = readers[i]->IsWriterGone();
+
+        records.clear();
+        for (const auto& reader : readers)
+            reader->Drain(records);
+
+        // One ordered stream for the host: merge what every ring had by the time it was logged.
+        std::stable_sort(records.begin(), records.end(),
+                         [](const auto& lhs, const auto& rhs) { return lhs.timestamp < rhs.timestamp; });
+        for (auto& record : records)
+        {
+            // Stamped with the worker's time, not the drain time, so {datetime} shows when it was logged.
+            const auto time = std::chrono::system_clock::time_point{ std::chrono::duration_cast<
+                std::chrono::system_clock::duration>(std::chrono::nanoseconds{ record.timestamp }) };
+            auto context = record.context.empty() ? nullptr : std::make_shared<const std::string>(record.context);
+            collector->Log(lgx::LogMsg{ .level      = record.level,
+                                        .message    = std::move(record.message),
+                                        .prefix     = fmt::format("{}:{}", record.prefix, record.pid),
+                                        .style      = collector->GetDefaultStyle(record.level),
+                                        .sampleRate = record.sampleRate,
+                                        .context    = std::move(context),
+                                        .time       = time });
+        }
+
+        for (std::size_t i = readers.size(); i-- > 0;)
+        {
+            if (!gone[i])
+                continue;
+            if (const auto dropped = readers[i]->GetDroppedCount(); dropped > 0)
+                collector->Warn("{} dropped {} records, its ring was full.", readers[i]->GetName(), dropped);
+            readers[i]->Unlink();
+            readers.erase(readers.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+
+        if (stopping)
+            break;
+
+        // Back off while idle, stay responsive while busy.
+        idle_sleep = records.empty() ? std::min(idle_sleep * 2, std::chrono::microseconds{ 10'000 })
+                                     : std::chrono::microseconds{ 100 };
+        std::this_thread::sleep_for(idle_sleep);
+    }
+    return 0;
+}
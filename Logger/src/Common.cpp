@@ -1,8 +1,15 @@
 #include "Common.h"
 
+#ifdef __unix__
+#include <cerrno>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <io.h>
+#endif
+
 namespace lgx {
     namespace utils {
-        [[nodiscard]] auto DeserializeFmtColorType(const std::string_view serializedString) noexcept
+        [[nodiscard]] LGX_INLINE auto DeserializeFmtColorType(const std::string_view serializedString) noexcept
             -> std::optional<fmt::detail::color_type>
         {
             fmt::detail::color_type type;
@@ -20,7 +27,8 @@ namespace lgx {
             return type;
         }
 
-        [[nodiscard]] auto DeserializeFmtStyle(const std::string_view serializedString) noexcept -> fmt::text_style
+        [[nodiscard]] LGX_INLINE auto DeserializeFmtStyle(const std::string_view serializedString) noexcept
+            -> fmt::text_style
         {
             fmt::text_style style;
             const auto fg_color_start = serializedString.find("foreground_color=") + sizeof("foreground_color=") - 1;
@@ -87,9 +95,65 @@ namespace lgx {
 
             return style;
         }
+
+        [[nodiscard]] LGX_INLINE auto LocalTime(const std::time_t time) noexcept -> std::tm
+        {
+            std::tm result = {};
+#ifdef _WIN32
+            ::localtime_s(&result, &time);
+#else
+            ::localtime_r(&time, &result);
+#endif
+            return result;
+        }
+
+        [[nodiscard]] LGX_INLINE auto UtcTime(const std::time_t time) noexcept -> std::tm
+        {
+            std::tm result = {};
+#ifdef _WIN32
+            ::gmtime_s(&result, &time);
+#else
+            ::gmtime_r(&time, &result);
+#endif
+            return result;
+        }
+
+        LGX_INLINE auto IsStdoutTerminal() noexcept -> bool
+        {
+#ifdef __unix__
+            static const bool is_terminal = ::isatty(STDOUT_FILENO) == 1;
+#elif defined(_WIN32)
+            static const bool is_terminal = ::_isatty(::_fileno(stdout)) != 0;
+#else
+            static const bool is_terminal = true;
+#endif
+            return is_terminal;
+        }
+
+        LGX_INLINE auto WriteBatch(const int fd, std::string_view batch) noexcept -> bool
+        {
+#ifdef __unix__
+            while (!batch.empty())
+            {
+                const auto written = ::write(fd, batch.data(), batch.size());
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    return false;
+                }
+                batch.remove_prefix(static_cast<std::size_t>(written));
+            }
+            return true;
+#else
+            (void)fd;
+            (void)batch;
+            return false;
+#endif
+        }
     } // namespace utils
 
-    [[nodiscard]] auto LogMsg::FromString(const std::string_view serializedString) noexcept -> LogMsg
+    [[nodiscard]] LGX_INLINE auto LogMsg::FromString(const std::string_view serializedString) noexcept -> LogMsg
     {
         LogMsg msg;
 
@@ -129,6 +193,24 @@ namespace lgx {
             }
         }
 
+        const auto context_start = serializedString.find("context=");
+        if (context_start != std::string::npos)
+        {
+            const auto part        = serializedString.substr(context_start + sizeof("context=") - 1);
+            const auto context_str = part.substr(0, part.find(";") + 1);
+            if (context_str.compare("null;") != 0)
+            {
+                for (std::size_t i = 0; i < context_str.size(); ++i)
+                {
+                    if (context_str[i] == '\'' && context_str[i + 1] == ';')
+                    {
+                        msg.context = std::make_shared<const std::string>(context_str.substr(1, i - 1));
+                        break;
+                    }
+                }
+            }
+        }
+
         const auto level_start = serializedString.find("level=") + sizeof("level=") - 1;
         if (level_start != std::string::npos)
         {
@@ -168,13 +250,22 @@ namespace lgx {
             }
             msg.style = utils::DeserializeFmtStyle(serializedString.substr(style_start, end - style_start));
         }
+
+        const auto rate_start = serializedString.find("sampleRate=");
+        if (rate_start != std::string::npos)
+        {
+            const auto part = serializedString.substr(rate_start + sizeof("sampleRate=") - 1);
+            std::from_chars(part.data(), part.data() + part.size(), msg.sampleRate);
+        }
         return msg;
     }
 
-    [[nodiscard]] auto LogMsg::ToString(const LogMsg& log) noexcept -> std::string
+    [[nodiscard]] LGX_INLINE auto LogMsg::ToString(const LogMsg& log) noexcept -> std::string
     {
-        return fmt::format(
-            "{{message={};prefix={};level={};defaultStyle={}}}", (log.message.empty()) ? "null" : '\'' + log.message + '\'',
-            (log.prefix) ? '\'' + *log.prefix + '\'' : "null", log.level, utils::SerializeFmtStyle(log.style));
+        return fmt::format("{{message={};prefix={};context={};level={};defaultStyle={};sampleRate={}}}",
+                           (log.message.empty()) ? "null" : '\'' + log.message + '\'',
+                           (log.prefix) ? '\'' + *log.prefix + '\'' : "null",
+                           (log.context) ? '\'' + *log.context + '\'' : "null", log.level,
+                           utils::SerializeFmtStyle(log.style), log.sampleRate);
     }
 } // namespace lgx
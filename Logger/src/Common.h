@@ -1,21 +1,31 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <charconv>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <ctime>
 #include <deque>
 #include <filesystem>
+#include <fstream>
 #include <future>
 #include <iostream>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <stdexcept>
 #include <string>
+#include <syncstream>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <fmt/args.h>
 #include <fmt/chrono.h>
@@ -24,13 +34,20 @@
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
-#ifdef __unix__
-#include <syslog.h>
-#endif
-
 // TODO: Remove this macro and replace its instances with just inline.
 #define LGX_CONSTEXPR inline
 
+// Marks the definitions in the .cpp files. With LGX_HEADER_ONLY every header pulls in its .cpp so the whole library
+// is compiled (and can be inlined) into the user's translation units, LGX_INTERNAL then has to become inline as well
+// so file-local state like the crash handler's logger table stays a single instance.
+#ifdef LGX_HEADER_ONLY
+#define LGX_INLINE   inline
+#define LGX_INTERNAL inline
+#else
+#define LGX_INLINE
+#define LGX_INTERNAL static
+#endif
+
 namespace lgx {
     enum class Level : std::uint8_t
     {
@@ -50,6 +67,8 @@ namespace lgx {
 
     // For shorthand.
     using enum Level;
+
+    inline constexpr std::size_t LevelCount = static_cast<std::size_t>(Level::Verbose) + 1;
 } // namespace lgx
 
 namespace fmt {
@@ -90,21 +109,97 @@ namespace lgx {
                                style.has_background() ? SerializeFmtColorType(style.get_background()) : "{null}",
                                (style.has_emphasis()) ? static_cast<std::uint8_t>(style.get_emphasis()) : 0);
         }
+        // Orders levels by severity, Level's own values are not (Debug and Verbose come last).
+        [[nodiscard]] constexpr auto SeverityRank(const Level level) noexcept -> int
+        {
+            switch (level)
+            {
+                using enum Level;
+
+                case Verbose: return 0;
+                case Debug: return 1;
+                case Info: return 2;
+                case Warn: return 3;
+                case Error: return 4;
+                case Fatal: return 5;
+            }
+            return 0;
+        }
+        // Cheap per-thread xorshift64* generator, good enough for sampling decisions.
+        [[nodiscard]] inline auto FastRandom() noexcept -> std::uint64_t
+        {
+            thread_local std::uint64_t state =
+                (reinterpret_cast<std::uintptr_t>(&state) ^
+                 static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())) |
+                1;
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 0x2545F4914F6CDD1DULL;
+        }
+        // A shared_ptr that can be loaded and replaced concurrently: std::atomic<std::shared_ptr<T>> where the
+        // standard library has it, the older atomic free functions where it does not (libc++).
+        template <typename T>
+        class AtomicSharedPtr
+        {
+        private:
+#ifdef __cpp_lib_atomic_shared_ptr
+            std::atomic<std::shared_ptr<T>> m_Pointer;
+#else
+            std::shared_ptr<T> m_Pointer;
+#endif
+
+        public:
+            [[nodiscard]] inline auto Load(const std::memory_order order) const noexcept -> std::shared_ptr<T>
+            {
+#ifdef __cpp_lib_atomic_shared_ptr
+                return m_Pointer.load(order);
+#else
+                return std::atomic_load_explicit(&m_Pointer, order);
+#endif
+            }
+            inline auto Store(std::shared_ptr<T> pointer, const std::memory_order order) noexcept -> void
+            {
+#ifdef __cpp_lib_atomic_shared_ptr
+                m_Pointer.store(std::move(pointer), order);
+#else
+                std::atomic_store_explicit(&m_Pointer, std::move(pointer), order);
+#endif
+            }
+        };
         [[nodiscard]] auto DeserializeFmtColorType(const std::string_view serializedString) noexcept
             -> std::optional<fmt::detail::color_type>;
         [[nodiscard]] auto DeserializeFmtStyle(const std::string_view serializedString) noexcept -> fmt::text_style;
+
+        // Thread-safe std::localtime/std::gmtime, every logger's poll thread formats timestamps concurrently.
+        [[nodiscard]] auto LocalTime(std::time_t time) noexcept -> std::tm;
+        [[nodiscard]] auto UtcTime(std::time_t time) noexcept -> std::tm;
+
+        // Whether stdout is attached to a terminal, checked once per process.
+        [[nodiscard]] auto IsStdoutTerminal() noexcept -> bool;
+
+        // Writes a batch of records laid out back to back in one buffer to fd, retrying partial writes.
+        // Returns false on a write error (and on non-unix targets).
+        auto WriteBatch(int fd, std::string_view batch) noexcept -> bool;
     } // namespace utils
 
     struct LogMsg
     {
     public:
-        Level                      level;
-        std::string                message;
-        std::optional<std::string> prefix = std::nullopt;
-        fmt::text_style            style;
+        Level                                                level;
+        std::string                                          message;
+        std::optional<std::string>                           prefix = std::nullopt;
+        fmt::text_style                                      style;
+        float                                                sampleRate = 1.0f;         // Records it stands for.
+        std::shared_ptr<const std::string>                   context    = nullptr;      // Shared, not copied.
+        std::optional<std::chrono::system_clock::time_point> time       = std::nullopt; // Unset means write time.
 
     public:
         [[nodiscard]] static auto FromString(const std::string_view serializedString) noexcept -> LogMsg;
         [[nodiscard]] static auto ToString(const LogMsg& log) noexcept -> std::string;
     };
 } // namespace lgx
+
+#ifdef LGX_HEADER_ONLY
+#include "Common.cpp"
+#endif
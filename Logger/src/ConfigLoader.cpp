@@ -0,0 +1,405 @@
+#include "ConfigLoader.h"
+
+#include <cctype>
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace lgx {
+    [[nodiscard]] LGX_INTERNAL auto Trim(std::string_view text) noexcept -> std::string_view
+    {
+        constexpr std::string_view whitespace = " \t\r\n";
+
+        const auto first = text.find_first_not_of(whitespace);
+        if (first == std::string_view::npos)
+            return {};
+        return text.substr(first, text.find_last_not_of(whitespace) - first + 1);
+    }
+
+    [[nodiscard]] LGX_INTERNAL auto ToLower(const std::string_view text) -> std::string
+    {
+        std::string lower{ text };
+        std::transform(lower.begin(), lower.end(), lower.begin(),
+                       [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return lower;
+    }
+
+    [[nodiscard]] LGX_INTERNAL auto ParseLevel(const std::string_view name) -> std::optional<Level>
+    {
+        const auto lower = ToLower(name);
+        for (std::size_t i = 0; i < LevelCount; ++i)
+        {
+            const auto level = static_cast<Level>(i);
+            if (lower == ToLower(fmt::format("{}", level)))
+                return level;
+        }
+        return std::nullopt;
+    }
+
+    // Formats a dummy record the way Logger::InternalLog does, so a bad format is rejected here instead of throwing
+    // on the logger's poll thread. Returns why the format is unusable, if it is.
+    [[nodiscard]] LGX_INTERNAL auto ValidateFormat(const std::string_view format) -> std::optional<std::string>
+    {
+        if (format.find("{msg}") == std::string_view::npos)
+            return "A message is always required, the format must contain {msg}.";
+
+        try
+        {
+            [[maybe_unused]] const auto line =
+                fmt::format(fmt::runtime(format), fmt::arg("datetime", std::string_view{}),
+                            fmt::arg("level", Level::Info), fmt::arg("prefix", std::string_view{}),
+                            fmt::arg("context", std::string_view{}), fmt::arg("sample_rate", 1.0f),
+                            fmt::arg("msg", std::string_view{}));
+        }
+        catch (const fmt::format_error& error)
+        {
+            return fmt::format("Invalid format: {}", error.what());
+        }
+        return std::nullopt;
+    }
+
+    LGX_INLINE ConfigLoader::ConfigLoader(std::filesystem::path path)
+        : m_Path(std::move(path))
+    {
+        // Constructs the registry before the loader, so it is also destroyed after it when the loader is a static:
+        // the destructor still has to detach the loader's files from registry loggers.
+        [[maybe_unused]] auto& global = GetGlobal();
+    }
+
+    LGX_INLINE ConfigLoader::~ConfigLoader() noexcept
+    {
+        StopWatching();
+
+        const std::lock_guard<std::mutex> lock{ m_Guard };
+        for (const auto& name : m_Configured)
+        {
+            Get(name).UpdateProperties(
+                [this](Logger::Properties& properties)
+                {
+                    std::erase_if(properties.outputStreams,
+                                  [this](const std::ostream* stream) { return IsOwnedStream(stream); });
+                });
+        }
+        m_Files.clear();
+    }
+
+    LGX_INLINE auto ConfigLoader::Parse(std::istream& input, std::vector<LoggerConfig>& configs) -> bool
+    {
+        std::string line;
+        std::size_t line_number = 0;
+        std::size_t current     = configs.size(); // No section yet.
+
+        const auto fail = [&](const std::string_view reason)
+        {
+            m_LastError = fmt::format("{}:{}: {}", m_Path.string(), line_number, reason);
+            return false;
+        };
+
+        while (std::getline(input, line))
+        {
+            ++line_number;
+            const auto text = Trim(line);
+            if (text.empty() || text.front() == '#' || text.front() == ';')
+                continue;
+
+            if (text.front() == '[')
+            {
+                if (text.back() != ']')
+                    return fail("Unterminated [logger] section.");
+                const auto name = Trim(text.substr(1, text.size() - 2));
+                if (name.empty())
+                    return fail("Empty logger name.");
+
+                // Repeated sections are merged, later keys win.
+                const auto it = std::find_if(configs.begin(), configs.end(),
+                                             [name](const LoggerConfig& config) { return config.name == name; });
+                current       = static_cast<std::size_t>(it - configs.begin());
+                if (it == configs.end())
+                    configs.emplace_back().name = name;
+                continue;
+            }
+
+            const auto equals = text.find('=');
+            if (equals == std::string_view::npos)
+                return fail("Expected key = value.");
+            if (current == configs.size())
+                return fail("Key outside of a [logger] section.");
+
+            auto&      config = configs[current];
+            const auto key    = ToLower(Trim(text.substr(0, equals)));
+            const auto value  = Trim(text.substr(equals + 1));
+            if (key == "level")
+            {
+                config.level = ParseLevel(value);
+                if (!config.level)
+                    return fail(fmt::format("Unknown level '{}'.", value));
+            }
+            else if (key == "format")
+            {
+                if (const auto error = ValidateFormat(value))
+                    return fail(*error);
+                config.format = std::string{ value };
+            }
+            else if (key == "sinks")
+            {
+                auto& sinks = config.sinks.emplace();
+                for (std::size_t begin = 0; begin <= value.size();)
+                {
+                    const auto end  = std::min(value.find(',', begin), value.size());
+                    const auto sink = Trim(value.substr(begin, end - begin));
+                    if (!sink.empty())
+                        sinks.emplace_back(sink);
+                    begin = end + 1;
+                }
+            }
+            else
+                return fail(fmt::format("Unknown key '{}'.", key));
+        }
+
+        if (input.bad())
+            return fail("Read error.");
+        return true;
+    }
+
+    LGX_INLINE auto ConfigLoader::ResolveSinks(const std::string& logger, const std::vector<std::string>& sinks,
+                                               std::vector<std::ostream*>& streams, std::vector<int>& fds,
+                                               bool& syslog) -> bool
+    {
+        constexpr std::string_view file_scheme = "file:";
+        constexpr std::string_view fd_scheme   = "fd:";
+
+        for (const std::string_view sink : sinks)
+        {
+            if (sink == "stdout")
+                streams.push_back(&std::cout);
+            else if (sink == "stderr")
+                streams.push_back(&std::cerr);
+            else if (sink == "syslog")
+                syslog = true;
+            else if (sink.starts_with(fd_scheme))
+            {
+                const auto number = sink.substr(fd_scheme.size());
+                int        fd     = -1;
+                const auto result = std::from_chars(number.data(), number.data() + number.size(), fd);
+                if (result.ec != std::errc{} || result.ptr != number.data() + number.size() || fd < 0)
+                {
+                    m_LastError = fmt::format("{}: Invalid file descriptor in sink '{}'.", m_Path.string(), sink);
+                    return false;
+                }
+                fds.push_back(fd);
+            }
+            else if (sink.starts_with(file_scheme))
+            {
+                // Files are shared by path, so reloading or listing one for several loggers keeps a single stream.
+                const auto path = std::string{ Trim(sink.substr(file_scheme.size())) };
+                auto&      file = m_Files[path];
+                if (!file.file.is_open())
+                    file.file.open(path, std::ios::app);
+                if (!file.file)
+                {
+                    m_Files.erase(path);
+                    m_LastError = fmt::format("{}: Cannot open '{}' for sink '{}'.", m_Path.string(), path, sink);
+                    return false;
+                }
+                auto& writer = file.writers[logger];
+                if (!writer)
+                {
+                    writer = std::make_unique<std::osyncstream>(file.file);
+                    *writer << std::emit_on_flush;
+                }
+                streams.push_back(writer.get());
+            }
+            else
+            {
+                m_LastError = fmt::format("{}: Unknown sink '{}'.", m_Path.string(), sink);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    LGX_INLINE auto ConfigLoader::IsOwnedStream(const std::ostream* stream) const noexcept -> bool
+    {
+        return std::any_of(m_Files.begin(), m_Files.end(),
+                           [stream](const auto& file)
+                           {
+                               const auto& writers = file.second.writers;
+                               return std::any_of(writers.begin(), writers.end(), [stream](const auto& writer)
+                                                  { return writer.second.get() == stream; });
+                           });
+    }
+
+    LGX_INLINE auto ConfigLoader::CloseUnusedFiles() noexcept -> void
+    {
+        for (auto& [path, file] : m_Files)
+        {
+            std::erase_if(file.writers,
+                          [](const auto& writer)
+                          {
+                              const auto streams = Get(writer.first).GetOutputStreams();
+                              return std::find(streams.begin(), streams.end(), writer.second.get()) == streams.end();
+                          });
+        }
+        std::erase_if(m_Files, [](const auto& file) { return file.second.writers.empty(); });
+    }
+
+    LGX_INLINE auto ConfigLoader::Load() -> bool
+    {
+        struct Outputs
+        {
+            std::vector<std::ostream*> streams;
+            std::vector<int>           fds;
+            bool                       syslog = false;
+        };
+
+        const std::lock_guard<std::mutex> lock{ m_Guard };
+        m_LastError.clear();
+
+        std::ifstream file{ m_Path };
+        if (!file)
+        {
+            m_LastError = fmt::format("{}: Cannot open the file.", m_Path.string());
+            return false;
+        }
+
+        std::vector<LoggerConfig> configs;
+        if (!Parse(file, configs))
+            return false;
+
+        // Resolve every sink list before any logger is touched, a file that cannot be opened aborts the whole load.
+        std::vector<std::optional<Outputs>> outputs(configs.size());
+        for (std::size_t i = 0; i < configs.size(); ++i)
+        {
+            if (!configs[i].sinks)
+                continue;
+
+            auto& output = outputs[i].emplace();
+            if (!ResolveSinks(configs[i].name, *configs[i].sinks, output.streams, output.fds, output.syslog))
+            {
+                CloseUnusedFiles();
+                return false;
+            }
+        }
+
+        for (std::size_t i = 0; i < configs.size(); ++i)
+        {
+            const auto& config = configs[i];
+            auto&       output = outputs[i];
+            Get(config.name).UpdateProperties(
+                [&](Logger::Properties& properties)
+                {
+                    // The file is authoritative, a verbose flag set in code would otherwise override its level.
+                    if (config.level)
+                    {
+                        properties.level   = *config.level;
+                        properties.verbose = *config.level == Level::Verbose;
+                    }
+                    if (config.format)
+                        properties.defaultStyle.format = *config.format;
+                    if (output)
+                    {
+                        properties.outputStreams = std::move(output->streams);
+                        properties.outputFds     = std::move(output->fds);
+                        properties.syslog        = output->syslog;
+                    }
+                });
+
+            if (output && std::find(m_Configured.begin(), m_Configured.end(), config.name) == m_Configured.end())
+                m_Configured.push_back(config.name);
+        }
+
+        // Loggers switched away from a file have stopped writing to it once UpdateProperties returned.
+        CloseUnusedFiles();
+        return true;
+    }
+
+    LGX_INLINE auto ConfigLoader::Watch() -> bool
+    {
+#ifdef __linux__
+        const std::lock_guard<std::mutex> lock{ m_Guard };
+        if (m_WatchThread.valid())
+            return true;
+
+        // The directory is watched rather than the file, editors and deployment tools usually replace it by renaming
+        // a new one over it, which a watch on the old inode would never see.
+        const auto directory = m_Path.has_parent_path() ? m_Path.parent_path() : std::filesystem::path{ "." };
+        const int  inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd < 0)
+            return false;
+        if (::inotify_add_watch(inotify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0 ||
+            ::pipe2(m_StopPipe, O_CLOEXEC) < 0)
+        {
+            ::close(inotify_fd);
+            return false;
+        }
+
+        m_WatchThread = std::async(std::launch::async, &ConfigLoader::WatchLoop, this, inotify_fd);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    LGX_INLINE auto ConfigLoader::WatchLoop(const int inotifyFd) -> void
+    {
+#ifdef __linux__
+        const auto name = m_Path.filename().string();
+
+        alignas(inotify_event) char buffer[4096];
+        pollfd                      fds[2] = { { inotifyFd, POLLIN, 0 }, { m_StopPipe[0], POLLIN, 0 } };
+        while (true)
+        {
+            if (::poll(fds, 2, -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                break;
+            }
+            if (fds[1].revents != 0)
+                break;
+
+            bool changed = false;
+            long size    = 0;
+            while ((size = ::read(inotifyFd, buffer, sizeof(buffer))) > 0)
+            {
+                for (long offset = 0; offset < size;)
+                {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    if (event->len > 0 && name == event->name)
+                        changed = true;
+                    offset += static_cast<long>(sizeof(inotify_event) + event->len);
+                }
+            }
+
+            if (changed && !Load())
+                GetGlobal().Log(Level::Warn, "Config reload failed, keeping the previous settings. {}",
+                                GetLastError());
+        }
+        ::close(inotifyFd);
+#else
+        static_cast<void>(inotifyFd);
+#endif
+    }
+
+    LGX_INLINE auto ConfigLoader::StopWatching() noexcept -> void
+    {
+#ifdef __linux__
+        if (!m_WatchThread.valid())
+            return;
+
+        const char stop = 0;
+        [[maybe_unused]] const auto written = ::write(m_StopPipe[1], &stop, 1);
+        m_WatchThread.wait();
+        m_WatchThread = {};
+
+        ::close(m_StopPipe[0]);
+        ::close(m_StopPipe[1]);
+        m_StopPipe[0] = m_StopPipe[1] = -1;
+#endif
+    }
+} // namespace lgx
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Logger.h"
+
+namespace lgx {
+    // Applies per-logger settings from an INI-style file to loggers in the lgx::Get registry, and with Watch()
+    // re-applies them whenever the file changes so verbosity can be turned up on a live process:
+    //
+    //     # Loggers that are not listed keep their current settings.
+    //     [global]
+    //     level  = warn
+    //
+    //     [net]
+    //     level  = debug
+    //     format = [{datetime}] [{level}] net: {msg}
+    //     sinks  = stderr, file:/var/log/app/net.log
+    //
+    // level is the least severe level written (verbose, debug, info, warn, error or fatal). sinks replaces all of
+    // the logger's outputs and takes stdout, stderr, syslog, fd:<n> and file:<path>, files are appended to and owned
+    // by the loader. Loggers listing the same file share one descriptor and each emit whole lines into it. Lines
+    // starting with # or ; are comments.
+    //
+    // A file is parsed and validated completely before anything is applied, one with errors changes nothing. Each
+    // logger's settings are then swapped in under its own lock, so no record is written with half an update and
+    // logging never pauses beyond that.
+    class ConfigLoader
+    {
+    private:
+        // One open file and a synchronized writer for each logger using it: the loggers' poll threads write
+        // concurrently, a writer buffers a line and hands it to the file under the file's lock on std::endl.
+        struct SharedFile
+        {
+            std::ofstream                                                      file;
+            std::unordered_map<std::string, std::unique_ptr<std::osyncstream>> writers; // Keyed by logger name.
+        };
+        struct LoggerConfig
+        {
+            std::string                             name;
+            std::optional<Level>                    level;
+            std::optional<std::string>              format;
+            std::optional<std::vector<std::string>> sinks;
+        };
+
+    private:
+        std::filesystem::path                                           m_Path;
+        std::string                                                     m_LastError;
+        std::unordered_map<std::string, SharedFile> m_Files;      // Keyed by path.
+        std::vector<std::string>                    m_Configured; // Loggers given sinks so far.
+        std::future<void>                           m_WatchThread;
+        int                                         m_StopPipe[2] = { -1, -1 };
+        mutable std::mutex                          m_Guard; // Serializes loads.
+
+    public:
+        explicit ConfigLoader(std::filesystem::path path);
+        ~ConfigLoader() noexcept;
+        ConfigLoader(const ConfigLoader&)            = delete;
+        ConfigLoader& operator=(const ConfigLoader&) = delete;
+
+    public:
+        [[nodiscard]] inline auto GetPath() const noexcept -> const std::filesystem::path& { return m_Path; }
+        // Why the last Load() failed, empty if it succeeded.
+        [[nodiscard]] inline auto GetLastError() const noexcept -> std::string
+        {
+            const std::lock_guard<std::mutex> lock{ m_Guard };
+            return m_LastError;
+        }
+
+    private:
+        [[nodiscard]] auto Parse(std::istream& input, std::vector<LoggerConfig>& configs) -> bool;
+        [[nodiscard]] auto ResolveSinks(const std::string& logger, const std::vector<std::string>& sinks,
+                                        std::vector<std::ostream*>& streams, std::vector<int>& fds, bool& syslog)
+            -> bool;
+        [[nodiscard]] auto IsOwnedStream(const std::ostream* stream) const noexcept -> bool;
+        // Drops the writers their logger no longer uses and closes the files left without any.
+        auto CloseUnusedFiles() noexcept -> void;
+        auto WatchLoop(int inotifyFd) -> void;
+        auto StopWatching() noexcept -> void;
+
+    public:
+        // Reads the file and applies it, returning false (and applying nothing) if it cannot be read or is invalid.
+        auto Load() -> bool;
+        // Reloads the file on a background thread every time it is written or replaced, failed reloads are reported
+        // on the global logger and keep the previous settings. Linux only (inotify), returns false elsewhere.
+        auto Watch() -> bool;
+    };
+} // namespace lgx
+
+#ifdef LGX_HEADER_ONLY
+#include "ConfigLoader.cpp"
+#endif
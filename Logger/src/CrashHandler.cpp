@@ -0,0 +1,132 @@
+#include "CrashHandler.h"
+#include "Logger.h"
+
+#ifdef __unix__
+#include <csignal>
+#include <unistd.h>
+#endif
+
+namespace lgx {
+    namespace crash {
+        LGX_INTERNAL std::array<std::atomic<const Logger*>, MaxLoggers> g_Loggers{};
+        LGX_INTERNAL std::atomic<int>                                   g_CrashFd = -1;
+
+        LGX_INLINE auto Register(const Logger* logger) noexcept -> void
+        {
+            for (auto& slot : g_Loggers)
+            {
+                const Logger* expected = nullptr;
+                if (slot.compare_exchange_strong(expected, logger, std::memory_order_acq_rel))
+                    return;
+            }
+        }
+
+        LGX_INLINE auto Unregister(const Logger* logger) noexcept -> void
+        {
+            for (auto& slot : g_Loggers)
+            {
+                const Logger* expected = logger;
+                if (slot.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel))
+                    return;
+            }
+        }
+
+#ifdef __unix__
+        LGX_INTERNAL auto WriteAll(const int fd, const char* data, std::size_t size) noexcept -> void
+        {
+            while (size > 0)
+            {
+                const auto written = ::write(fd, data, size);
+                if (written <= 0)
+                    return;
+                data += written;
+                size -= static_cast<std::size_t>(written);
+            }
+        }
+
+        LGX_INTERNAL auto WriteAll(const int fd, const std::string_view str) noexcept -> void
+        {
+            WriteAll(fd, str.data(), str.size());
+        }
+
+        LGX_INTERNAL auto DumpRecord(const int fd, const LogMsg& log, const std::string_view defaultPrefix) noexcept
+            -> void
+        {
+            static constexpr std::string_view c_LevelNames[LevelCount] = { "Info",  "Warn",  "Error",
+                                                                           "Fatal", "Debug", "Verbose" };
+
+            const auto index = static_cast<std::size_t>(log.level);
+            WriteAll(fd, "[");
+            WriteAll(fd, index < LevelCount ? c_LevelNames[index] : "?");
+            WriteAll(fd, "] (");
+            WriteAll(fd, log.prefix ? std::string_view{ *log.prefix } : defaultPrefix);
+            WriteAll(fd, ")");
+            if (const auto& context = log.context)
+            {
+                WriteAll(fd, " {");
+                WriteAll(fd, *context);
+                WriteAll(fd, "}");
+            }
+            WriteAll(fd, ": ");
+            WriteAll(fd, log.message);
+            WriteAll(fd, "\n");
+        }
+
+        LGX_INTERNAL constexpr int c_Signals[] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };
+
+        LGX_INTERNAL void OnCrash(const int sig)
+        {
+            const int fd = g_CrashFd.load(std::memory_order_relaxed);
+            if (fd >= 0)
+            {
+                for (const auto& slot : g_Loggers)
+                {
+                    if (const auto* logger = slot.load(std::memory_order_acquire))
+                        logger->DumpPending(fd);
+                }
+            }
+
+            // SA_RESETHAND already restored the default disposition, re-raise so the process dies as it would have.
+            raise(sig);
+        }
+#endif
+    } // namespace crash
+
+    LGX_INLINE auto Logger::DumpPending(const int fd) const noexcept -> void
+    {
+#ifdef __unix__
+        const std::string_view default_prefix = m_Properties.defaultPrefix;
+
+        // Oldest first: what the poll thread has taken but not written yet, then everything still queued.
+        const auto batch_size = m_BatchSize.load(std::memory_order_acquire);
+        for (auto i = m_BatchWritten.load(std::memory_order_acquire); i < batch_size && i < m_Batch.size(); ++i)
+            crash::DumpRecord(fd, m_Batch[i], default_prefix);
+        for (std::size_t i = 0; i < m_QueueSize && i < m_LogQueue.size(); ++i)
+            crash::DumpRecord(fd, m_LogQueue[i], default_prefix);
+#else
+        (void)fd;
+#endif
+    }
+
+    LGX_INLINE auto InstallCrashHandler(const int fd) noexcept -> bool
+    {
+#ifdef __unix__
+        crash::g_CrashFd.store(fd, std::memory_order_relaxed);
+
+        struct sigaction action = {};
+        action.sa_handler       = &crash::OnCrash;
+        action.sa_flags         = SA_RESETHAND | SA_NODEFER;
+        sigemptyset(&action.sa_mask);
+
+        for (const int sig : crash::c_Signals)
+        {
+            if (sigaction(sig, &action, nullptr) != 0)
+                return false;
+        }
+        return true;
+#else
+        (void)fd;
+        return false;
+#endif
+    }
+} // namespace lgx
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+namespace lgx {
+    class Logger;
+
+    namespace crash {
+        // Upper bound on loggers that can be dumped by the crash handler at once.
+        inline constexpr std::size_t MaxLoggers = 64;
+
+        auto Register(const Logger* logger) noexcept -> void;
+        auto Unregister(const Logger* logger) noexcept -> void;
+    } // namespace crash
+
+    // Opt-in crash handler. On SIGSEGV, SIGABRT, SIGBUS, SIGFPE or SIGILL every live logger's unwritten records are
+    // written to the pre-opened file descriptor using only async-signal-safe calls, then the signal is re-raised
+    // with its default disposition. Returns false if the handler could not be installed (or on non-unix targets).
+    [[nodiscard]] auto InstallCrashHandler(int fd) noexcept -> bool;
+} // namespace lgx
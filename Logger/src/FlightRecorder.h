@@ -0,0 +1,186 @@
+#pragma once
+
+#include "Common.h"
+
+namespace lgx {
+    // In-memory circular buffer holding the last N records (or last M bytes) in a preallocated arena.
+    // Records are stored raw and only formatted when dumped, their context snapshot is shared rather than copied.
+    class FlightRecorder
+    {
+    public:
+        struct Properties
+        {
+            std::size_t   maxRecords     = 1024;
+            std::size_t   maxBytes       = 64 * 1024;
+            std::ostream* dumpStream     = &std::cerr;
+            bool          dumpOnError    = true; // Dump to dumpStream when an Error or Fatal record arrives.
+            std::string   format         = "[{datetime}] [{level}] ({prefix}): {msg}"; // Same placeholders as Logger.
+            std::string   dateTimeFormat = "%Y-%m-%d %H:%M:%S";
+        };
+
+    private:
+        struct Entry
+        {
+            Level                                 level;
+            float                                 sampleRate;
+            std::chrono::system_clock::time_point time;
+            std::shared_ptr<const std::string>    context;
+            std::size_t                           offset;
+            std::size_t                           prefixSize;
+            std::size_t                           messageSize;
+        };
+
+    private:
+        Properties         m_Properties;
+        std::vector<char>  m_Arena;
+        std::vector<Entry> m_Entries;
+        std::size_t        m_FirstEntry = 0;
+        std::size_t        m_EntryCount = 0;
+        std::size_t        m_Head       = 0; // Next free byte in the arena.
+        std::size_t        m_UsedBytes  = 0;
+        mutable std::mutex m_Guard;
+
+    public:
+        FlightRecorder()
+            : FlightRecorder(Properties{})
+        {
+        }
+        // Throws std::invalid_argument if format or dateTimeFormat is unusable, rather than failing on the poll
+        // thread at the first dump.
+        FlightRecorder(Properties properties)
+            : m_Properties(std::move(properties))
+            , m_Arena(std::max<std::size_t>(m_Properties.maxBytes, 1))
+            , m_Entries(std::max<std::size_t>(m_Properties.maxRecords, 1))
+        {
+            ValidateFormats();
+        }
+        FlightRecorder(const FlightRecorder&)            = delete;
+        FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    public:
+        [[nodiscard]] inline auto GetRecordCount() const noexcept -> std::size_t
+        {
+            const std::lock_guard<std::mutex> lock{ m_Guard };
+            return m_EntryCount;
+        }
+        inline auto SetDumpOnError(const bool enable) noexcept -> void
+        {
+            const std::lock_guard<std::mutex> lock{ m_Guard };
+            m_Properties.dumpOnError = enable;
+        }
+        inline auto SetDumpStream(std::ostream* os) noexcept -> void
+        {
+            const std::lock_guard<std::mutex> lock{ m_Guard };
+            m_Properties.dumpStream = os;
+        }
+
+    private:
+        // Formats a dummy record the way DumpLocked does.
+        inline auto ValidateFormats() const -> void
+        {
+            try
+            {
+                [[maybe_unused]] const auto datetime =
+                    fmt::format(fmt::runtime("{:" + m_Properties.dateTimeFormat + '}'), utils::LocalTime(0));
+                [[maybe_unused]] const auto line =
+                    fmt::format(fmt::runtime(m_Properties.format), fmt::arg("datetime", std::string_view{}),
+                                fmt::arg("level", Level::Info), fmt::arg("sample_rate", 1.0f),
+                                fmt::arg("context", std::string_view{}), fmt::arg("prefix", std::string_view{}),
+                                fmt::arg("msg", std::string_view{}));
+            }
+            catch (const fmt::format_error& error)
+            {
+                throw std::invalid_argument(fmt::format("Invalid flight recorder format: {}", error.what()));
+            }
+        }
+        inline auto PopOldest() noexcept -> void
+        {
+            auto& oldest = m_Entries[m_FirstEntry];
+            m_UsedBytes -= oldest.prefixSize + oldest.messageSize;
+            oldest.context.reset();
+            m_FirstEntry = (m_FirstEntry + 1) % m_Entries.size();
+            --m_EntryCount;
+        }
+        inline auto CopyIn(const std::string_view data) noexcept -> void
+        {
+            const auto first = std::min(data.size(), m_Arena.size() - m_Head);
+            std::memcpy(m_Arena.data() + m_Head, data.data(), first);
+            std::memcpy(m_Arena.data(), data.data() + first, data.size() - first);
+            m_Head = (m_Head + data.size()) % m_Arena.size();
+        }
+        inline auto CopyOut(const std::size_t offset, const std::size_t size) const -> std::string
+        {
+            std::string out(size, '\0');
+            const auto  first = std::min(size, m_Arena.size() - offset);
+            std::memcpy(out.data(), m_Arena.data() + offset, first);
+            std::memcpy(out.data() + first, m_Arena.data(), size - first);
+            return out;
+        }
+        inline auto DumpLocked(std::ostream& os) -> void
+        {
+            for (; m_EntryCount > 0; PopOldest())
+            {
+                const auto& entry = m_Entries[m_FirstEntry];
+
+                auto arg_store = fmt::dynamic_format_arg_store<fmt::format_context>{};
+                auto time_obj  = std::chrono::system_clock::to_time_t(entry.time);
+                arg_store.push_back(fmt::arg(
+                    "datetime",
+                    fmt::format(fmt::runtime("{:" + m_Properties.dateTimeFormat + '}'), utils::LocalTime(time_obj))));
+                arg_store.push_back(fmt::arg("level", entry.level));
+                arg_store.push_back(fmt::arg("sample_rate", entry.sampleRate));
+                arg_store.push_back(fmt::arg("context", entry.context ? std::string_view{ *entry.context } : ""));
+                arg_store.push_back(fmt::arg("prefix", CopyOut(entry.offset, entry.prefixSize)));
+                arg_store.push_back(fmt::arg(
+                    "msg", CopyOut((entry.offset + entry.prefixSize) % m_Arena.size(), entry.messageSize)));
+                os << fmt::vformat(m_Properties.format, arg_store) << '\n';
+            }
+            m_Head = 0;
+            os.flush();
+        }
+
+    public:
+        // Stores the record, evicting the oldest ones until it fits. Messages larger than the arena are truncated.
+        inline auto Record(const LogMsg& log, const std::string_view defaultPrefix) -> void
+        {
+            const std::lock_guard<std::mutex> lock{ m_Guard };
+
+            const std::string_view prefix  = log.prefix ? std::string_view{ *log.prefix } : defaultPrefix;
+            const std::string_view message = std::string_view{ log.message }.substr(
+                0, m_Arena.size() - std::min(prefix.size(), m_Arena.size()));
+            const auto size = std::min(prefix.size(), m_Arena.size()) + message.size();
+
+            while (m_EntryCount > 0 && (m_EntryCount == m_Entries.size() || m_UsedBytes + size > m_Arena.size()))
+                PopOldest();
+
+            m_Entries[(m_FirstEntry + m_EntryCount) % m_Entries.size()] =
+                Entry{ .level       = log.level,
+                       .sampleRate  = log.sampleRate,
+                       .time        = log.time.value_or(std::chrono::system_clock::now()),
+                       .context     = log.context,
+                       .offset      = m_Head,
+                       .prefixSize  = size - message.size(),
+                       .messageSize = message.size() };
+            ++m_EntryCount;
+            m_UsedBytes += size;
+            CopyIn(prefix.substr(0, size - message.size()));
+            CopyIn(message);
+
+            if (m_Properties.dumpOnError && m_Properties.dumpStream &&
+                (log.level == Level::Error || log.level == Level::Fatal))
+                DumpLocked(*m_Properties.dumpStream);
+        }
+        // Formats every held record into os, oldest first, and empties the buffer.
+        inline auto Dump(std::ostream& os) -> void
+        {
+            const std::lock_guard<std::mutex> lock{ m_Guard };
+            DumpLocked(os);
+        }
+        inline auto Dump() -> void
+        {
+            const std::lock_guard<std::mutex> lock{ m_Guard };
+            if (m_Properties.dumpStream)
+                DumpLocked(*m_Properties.dumpStream);
+        }
+    };
+} // namespace lgx
@@ -1,14 +1,14 @@
 #include "Logger.h"
 
 namespace lgx {
-    static auto CreateRegistryAndAppendGlobal() noexcept -> std::unordered_map<std::string, Logger> 
+    LGX_INTERNAL auto CreateRegistryAndAppendGlobal() noexcept -> std::unordered_map<std::string, Logger> 
     {
         std::unordered_map<std::string, Logger> loggers;
-        loggers["global"] = lgx::Logger { lgx::Logger::Properties { .defaultPrefix = "Global" }};
+        loggers.emplace("global", lgx::Logger { lgx::Logger::Properties { .defaultPrefix = "Global" }});
         return loggers;
     }
 
-    auto Get(const std::string& loggerName) -> Logger&
+    LGX_INLINE auto Get(const std::string& loggerName) -> Logger&
     {
         static std::unordered_map<std::string, Logger> loggers = CreateRegistryAndAppendGlobal();
         static std::shared_mutex                       global_registry_mutex;
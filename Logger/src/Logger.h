@@ -1,13 +1,27 @@
 #pragma once
 
 #include "Common.h"
+#include "CrashHandler.h"
+#include "FlightRecorder.h"
+#include "ScopedContext.h"
+#include "SharedRing.h"
+#include "StyleCache.h"
+#include "SyslogSink.h"
 
 namespace lgx {
     class Logger
     {
     public:
+#ifdef LGX_DEBUG
+        static constexpr Level DefaultLevel = Level::Debug;
+#else
+        static constexpr Level DefaultLevel = Level::Info;
+#endif
+
         struct DefaultStyle
         {
+            // Placeholders: {datetime}, {level}, {prefix}, {context} (see ScopedContext), {sample_rate} (how many
+            // records this one stands for, see SampleRate) and {msg}.
             std::string     format           = "[{datetime}] [{level}] ({prefix}): {msg}";
             fmt::text_style defaultInfoStyle = fmt::bg(fmt::color::dark_green) | fmt::fg(fmt::color::white);
             fmt::text_style defaultWarnStyle = fmt::bg(fmt::color::orange) | fmt::fg(fmt::color::black);
@@ -20,30 +34,81 @@ namespace lgx {
             fmt::text_style defaultVerboseStyle =
                 fmt::emphasis::italic | fmt::bg(fmt::color::gray) | fmt::fg(fmt::color::white);
         };
+        struct SampleRate
+        {
+            std::uint32_t oneIn       = 1;    // Keep every Nth record, 1 keeps them all.
+            float         probability = 1.0f; // Keep each record with probability p, 1 keeps them all.
+        };
         struct Properties
         {
-            std::string                loggerName                   = "Logex";
-            Type                       appType                      = Type::User;
-            std::vector<std::ostream*> outputStreams                = { &std::cout };
-            bool                       serializeToNonStdoutStreams  = false;
-            bool                       writeStyleToNonStdoutStreams = false;
-            bool                       verbose                      = false;
-            bool                       syslog                       = false;
-            std::string                defaultPrefix                = "App";
-            std::string                dateTimeFormat               = "%Y-%m-%d %H:%M:%S";
-            DefaultStyle               defaultStyle                 = DefaultStyle{};
+            std::string                        loggerName                   = "Logex";
+            Type                               appType                      = Type::User;
+            std::vector<std::ostream*>         outputStreams                = { &std::cout };
+            std::vector<int>                   outputFds                    = {}; // One write(2) per drained batch.
+            bool                               serializeToNonStdoutStreams  = false;
+            bool                               writeStyleToNonStdoutStreams = false;
+            bool                               styleOnlyOnTerminal          = true; // Plain std::cout when piped.
+            bool                               verbose                      = false;        // Verbose at any level.
+            Level                              level                        = DefaultLevel; // Least severe written.
+            bool                               syslog                       = false;
+            std::string                        defaultPrefix                = "App";
+            std::string                        dateTimeFormat               = "%Y-%m-%d %H:%M:%S";
+            DefaultStyle                       defaultStyle                 = DefaultStyle{};
+            std::array<SampleRate, LevelCount> sampleRates                  = {};
+            FlightRecorder*                    flightRecorder               = nullptr;
+            std::size_t                        recordBlockSize              = 256;
+            std::size_t                        recordPoolBytes              = 256 * 1024;       // Kept for reuse.
+            std::size_t                        maxQueuedBytes               = 64 * 1024 * 1024; // 0 is unbounded.
+            std::string                        syslogSocketPath             = "/dev/log";
+            std::string                        sharedRing                   = ""; // Non-empty routes to a collector.
+            std::size_t                        sharedRingSlots              = 4096;
+            std::size_t                        sharedRingSlotSize           = 512;
+        };
+
+    private:
+        // What producers need to push a record into the shared ring, published as one immutable snapshot so they
+        // never take m_Guard. Holding it keeps the ring alive even if the logger is moved or swapped meanwhile.
+        struct SharedRingRoute
+        {
+            std::shared_ptr<SharedRingWriter> writer;
+            std::string                       defaultPrefix;
         };
 
     private:
-        Properties                      m_Properties;
-        mutable std::future<void>       m_PollThread;
-        mutable std::condition_variable m_PollCV;
-        mutable bool                    m_Run;
-        mutable std::deque<LogMsg>      m_LogQueue;
-        mutable std::mutex              m_Guard;
+        Properties                          m_Properties;
+        std::future<void>                   m_PollThread;
+        std::mutex                          m_PollThreadGuard; // Serializes starting and stopping m_PollThread.
+        mutable std::condition_variable     m_PollCV;
+        bool                                m_Run = false; // Guarded by m_Guard like the queue.
+        mutable std::vector<LogMsg>         m_LogQueue; // Slots are recycled, only the first m_QueueSize are queued.
+        mutable std::size_t                 m_QueueSize    = 0;
+        mutable std::size_t                 m_QueuedBytes  = 0; // Counted against maxQueuedBytes with m_BatchBytes.
+        std::size_t                         m_BatchBytes   = 0;
+        mutable std::atomic<std::uint64_t>  m_QueueDropped = 0;
+        std::vector<LogMsg>                 m_Batch; // Taken off m_LogQueue and being written by the poll thread.
+        std::atomic<std::size_t>            m_BatchSize    = 0;
+        std::atomic<std::size_t>            m_BatchWritten = 0; // The crash handler dumps m_Batch from here on.
+        mutable fmt::memory_buffer          m_FdBatch; // Every fd line of the batch, written with one write(2).
+        mutable StyleCache                  m_StyleCache;
+        mutable std::unique_ptr<SyslogSink> m_Syslog;
+        std::shared_ptr<SharedRingWriter>   m_SharedRing;
+        mutable fmt::memory_buffer          m_Line;
+        mutable fmt::memory_buffer          m_DateTime;
+        mutable fmt::memory_buffer          m_DateTimeSpec;
+        mutable std::mutex                  m_Guard;
+        // Held by the poll thread while it writes a batch, and by setters (before m_Guard) so properties and sinks
+        // never change under a batch being written. Producers only ever take m_Guard.
+        mutable std::mutex                  m_WriteGuard;
+
+        // Lock-free mirror of m_Properties.sampleRates, the level filter and the shared ring for the hot path.
+        std::array<std::atomic<std::uint32_t>, LevelCount>         m_SampleOneIn;
+        std::array<std::atomic<float>, LevelCount>                 m_SampleProbability;
+        std::array<std::atomic<bool>, LevelCount>                  m_LevelQueued;
+        mutable std::array<std::atomic<std::uint64_t>, LevelCount> m_SampleCounters{}; // 1-in-N counters.
+        utils::AtomicSharedPtr<const SharedRingRoute>             m_SharedRingRoute; // Null without a ring.
 
     public:
-        [[nodiscard]] inline auto GetOutputStreams() const noexcept -> const std::vector<std::ostream*>&
+        [[nodiscard]] inline auto GetOutputStreams() const noexcept -> std::vector<std::ostream*>
         {
             const std::lock_guard<std::mutex> lock{ m_Guard };
             return m_Properties.outputStreams;
@@ -68,6 +133,25 @@ namespace lgx {
             const std::lock_guard<std::mutex> lock{ m_Guard };
             return m_Properties.syslog;
         }
+        [[nodiscard]] inline auto GetSyslogDropCount() const noexcept -> std::uint64_t
+        {
+            const std::lock_guard<std::mutex> lock{ m_WriteGuard }; // The poll thread creates the sink.
+            return m_Syslog ? m_Syslog->GetDroppedCount() : 0;
+        }
+        // Number of records dropped so far because maxQueuedBytes were already queued or being written.
+        [[nodiscard]] inline auto GetQueueDropCount() const noexcept -> std::uint64_t
+        {
+            return m_QueueDropped.load(std::memory_order_relaxed);
+        }
+        [[nodiscard]] inline auto IsSharedRingOpen() const noexcept -> bool
+        {
+            return m_SharedRingRoute.Load(std::memory_order_acquire) != nullptr;
+        }
+        [[nodiscard]] inline auto GetDefaultStyle(const Level level) const noexcept -> fmt::text_style
+        {
+            const std::lock_guard<std::mutex> lock{ m_Guard };
+            return DefaultStyleFromLevel(level);
+        }
         [[nodiscard]] inline auto GetDefaultInfoStyle() const noexcept -> fmt::text_style
         {
             const std::lock_guard<std::mutex> lock{ m_Guard };
@@ -98,97 +182,230 @@ namespace lgx {
             const std::lock_guard<std::mutex> lock{ m_Guard };
             return m_Properties.defaultStyle.defaultVerboseStyle;
         }
-        inline auto SetOutputStreams(std::vector<std::ostream*> oss) noexcept -> void
+        [[nodiscard]] inline auto GetSampleRate(const Level level) const noexcept -> SampleRate
         {
             const std::lock_guard<std::mutex> lock{ m_Guard };
+            return m_Properties.sampleRates[static_cast<std::size_t>(level)];
+        }
+        [[nodiscard]] inline auto GetLevel() const noexcept -> Level
+        {
+            const std::lock_guard<std::mutex> lock{ m_Guard };
+            return m_Properties.level;
+        }
+        [[nodiscard]] inline auto GetFlightRecorder() const noexcept -> FlightRecorder*
+        {
+            const std::lock_guard<std::mutex> lock{ m_Guard };
+            return m_Properties.flightRecorder;
+        }
+        inline auto SetOutputStreams(std::vector<std::ostream*> oss) noexcept -> void
+        {
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.outputStreams = std::move(oss);
         }
+        inline auto SetOutputFds(std::vector<int> fds) noexcept -> void
+        {
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
+            m_Properties.outputFds = std::move(fds);
+        }
         inline auto SetDefaultPrefix(const std::string_view newDefaultPrefix) noexcept -> void
         {
-            const std::lock_guard<std::mutex> lock{ m_Guard };
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.defaultPrefix = newDefaultPrefix;
+            SyncLockFreeState();
         }
         inline auto SetDateTimeFormat(const std::string_view newDateTimeFormat) noexcept -> void
         {
-            const std::lock_guard<std::mutex> lock{ m_Guard };
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.dateTimeFormat = newDateTimeFormat;
         }
         inline auto SetFormat(const std::string_view newFormat) noexcept -> void
         {
-            const std::lock_guard<std::mutex> lock{ m_Guard };
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.defaultStyle.format = newFormat;
         }
         inline auto SetDefaultInfoStyle(const fmt::text_style& newDefaultInfoStyle) noexcept -> void
         {
-            const std::lock_guard<std::mutex> lock{ m_Guard };
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.defaultStyle.defaultInfoStyle = newDefaultInfoStyle;
         }
         inline auto SetDefaultWarnStyle(const fmt::text_style& newDefaultWarnStyle) noexcept -> void
         {
-            const std::lock_guard<std::mutex> lock{ m_Guard };
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.defaultStyle.defaultWarnStyle = newDefaultWarnStyle;
         }
         inline auto SetDefaultErrorStyle(const fmt::text_style& newDefaultErrorStyle) noexcept -> void
         {
-            const std::lock_guard<std::mutex> lock{ m_Guard };
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.defaultStyle.defaultErrorStyle = newDefaultErrorStyle;
         }
         inline auto SetDefaultFatalStyle(const fmt::text_style& newDefaultFatalStyle) noexcept -> void
         {
-            const std::lock_guard<std::mutex> lock{ m_Guard };
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.defaultStyle.defaultFatalStyle = newDefaultFatalStyle;
         }
         inline auto SetDefaultDebugStyle(const fmt::text_style& newDefaultDebugStyle) noexcept -> void
         {
-            const std::lock_guard<std::mutex> lock{ m_Guard };
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.defaultStyle.defaultDebugStyle = newDefaultDebugStyle;
         }
         inline auto SetDefaultVerboseStyle(const fmt::text_style& newDefaultVerboseStyle) noexcept -> void
         {
-            const std::lock_guard<std::mutex> lock{ m_Guard };
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.defaultStyle.defaultVerboseStyle = newDefaultVerboseStyle;
         }
         inline auto SetVerbose(const bool enable) noexcept -> void
         {
-            const std::lock_guard<std::mutex> lock{ m_Guard };
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.verbose = enable;
+            SyncLockFreeState();
         }
         inline auto SetSyslog(const bool enable) noexcept -> void
         {
-            const std::lock_guard<std::mutex> lock{ m_Guard };
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
             m_Properties.syslog = enable;
         }
+        inline auto SetFlightRecorder(FlightRecorder* recorder) noexcept -> void
+        {
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
+            m_Properties.flightRecorder = recorder;
+            SyncLockFreeState();
+        }
+        inline auto SetLevel(const Level level) noexcept -> void
+        {
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
+            m_Properties.level = level;
+            SyncLockFreeState();
+        }
+        // Applies several property changes at once, records are never written with only some of them in effect.
+        // Properties only read at construction (sharedRing, sharedRingSlots, sharedRingSlotSize) are not re-applied.
+        template <typename TUpdate>
+        inline auto UpdateProperties(TUpdate&& update) -> void
+        {
+            const std::scoped_lock lock{ m_WriteGuard, m_Guard };
+            std::forward<TUpdate>(update)(m_Properties);
+            SyncLockFreeState();
+        }
+        inline auto SetSampleRate(const Level level, const SampleRate rate) noexcept -> void
+        {
+            const std::lock_guard<std::mutex> lock{ m_Guard };
+            m_Properties.sampleRates[static_cast<std::size_t>(level)] = rate;
+            SyncLockFreeState();
+        }
+        inline auto SetSampleRate(const Level level, const std::uint32_t oneIn) noexcept -> void
+        {
+            SetSampleRate(level, SampleRate{ .oneIn = oneIn });
+        }
+        inline auto SetSampleProbability(const Level level, const float probability) noexcept -> void
+        {
+            SetSampleRate(level, SampleRate{ .probability = probability });
+        }
 
     public:
-        Logger() noexcept {}
+        Logger() noexcept
+            : Logger(Properties{})
+        {
+        }
         Logger(Properties properties) noexcept
             : m_Properties(std::move(properties))
-            , m_Run(true)
         {
-            m_PollThread = std::async(std::launch::async, &Logger::PollLogs, this);
+            if (!m_Properties.sharedRing.empty())
+            {
+                m_SharedRing = std::make_shared<SharedRingWriter>(m_Properties.sharedRing, m_Properties.sharedRingSlots,
+                                                                  m_Properties.sharedRingSlotSize);
+                if (!m_SharedRing->IsOpen())
+                    m_SharedRing.reset();
+            }
+            SyncLockFreeState();
+            StartPolling();
+            crash::Register(this);
+
+            // Without its ring the logger writes to its own sinks, so records are not silently lost.
+            if (!m_Properties.sharedRing.empty() && !m_SharedRing)
+                Warn("Shared ring '{}' could not be opened, records are written by this process.",
+                     m_Properties.sharedRing);
         }
         ~Logger() noexcept
         {
-            m_Run = false;
-            m_PollCV.notify_all();
-
-            if (m_PollThread.valid())
-                m_PollThread.get();
+            crash::Unregister(this);
+            StopPolling();
         }
         Logger(const Logger& other) noexcept = delete;
+        // The moved-from logger's poll thread is stopped before its state is taken, records it had not picked up yet
+        // are taken over with it. It keeps no thread of its own afterwards.
         Logger(Logger&& other) noexcept
+        {
+            {
+                const std::lock_guard<std::mutex> lifecycle{ other.m_PollThreadGuard };
+                other.StopPolling();
+
+                const std::lock_guard<std::mutex> lock{ other.m_Guard };
+                TakeState(other);
+            }
+            StartPolling();
+            crash::Register(this);
+        }
+        Logger& operator=(Logger&& other) noexcept
         {
             if (this != &other)
             {
-                const std::lock_guard<std::mutex> lock1{ other.m_Guard };
+                // Both poll threads stop first, without waiting for producers to go quiet. Records neither of them
+                // picked up stay queued and are written by the new poll thread with the new properties.
+                const std::scoped_lock lifecycle{ m_PollThreadGuard, other.m_PollThreadGuard };
+                StopPolling();
+                other.StopPolling();
+                {
+                    const std::scoped_lock lock{ m_Guard, other.m_Guard };
+                    TakeState(other);
+                }
+                StartPolling();
+            }
+            return *this;
+        }
 
-                m_Properties = std::move(other.m_Properties);
-                m_LogQueue   = std::move(other.m_LogQueue);
-                m_Run        = true;
-                m_PollThread = std::async(std::launch::async, &Logger::PollLogs, this);
+    private:
+        // Must be called with m_PollThreadGuard held, or from a constructor or the destructor.
+        auto StartPolling() -> void
+        {
+            {
+                const std::lock_guard<std::mutex> lock{ m_Guard };
+                m_Run = true;
             }
+            m_PollThread = std::async(std::launch::async, &Logger::PollLogs, this);
+        }
+        // Returns once the poll thread has finished its batch, written what was queued when it saw the request and
+        // exited, so it never waits on producers. Anything queued after that stays in m_LogQueue, for TakeState to
+        // hand over (the destructor has nothing left by then, nobody may log during destruction).
+        // Same locking rules as StartPolling.
+        auto StopPolling() noexcept -> void
+        {
+            {
+                // Set under the lock so the poll thread cannot miss the wake-up between its check and its wait.
+                const std::lock_guard<std::mutex> lock{ m_Guard };
+                m_Run = false;
+            }
+            m_PollCV.notify_all();
+
+            if (m_PollThread.valid())
+                m_PollThread.get();
+        }
+        // Moves other's properties, sinks and leftover records into this logger. Both m_Guards must be held and
+        // other's poll thread stopped.
+        auto TakeState(Logger& other) noexcept -> void
+        {
+            m_Properties = std::move(other.m_Properties);
+            m_Syslog     = std::move(other.m_Syslog);
+            m_SharedRing = std::move(other.m_SharedRing);
+            other.m_SharedRingRoute.Store(nullptr, std::memory_order_release);
+            for (std::size_t i = 0; i < other.m_QueueSize; ++i)
+            {
+                if (m_QueueSize == m_LogQueue.size())
+                    m_LogQueue.emplace_back();
+                m_LogQueue[m_QueueSize++] = std::move(other.m_LogQueue[i]);
+            }
+            m_QueuedBytes += std::exchange(other.m_QueuedBytes, 0);
+            other.m_QueueSize = 0;
+            SyncLockFreeState();
         }
-        Logger& operator=(Logger&& other) noexcept { return Logger{ std::move(other) }.Swap(*this); }
 
     private:
         [[nodiscard]] constexpr auto DefaultStyleFromLevel(const Level level) const noexcept -> fmt::text_style
@@ -207,6 +424,71 @@ namespace lgx {
             }
         }
 
+        // Must be called with m_Guard held (or before the poll thread starts).
+        auto SyncLockFreeState() noexcept -> void
+        {
+            for (std::size_t i = 0; i < LevelCount; ++i)
+            {
+                m_SampleOneIn[i].store(m_Properties.sampleRates[i].oneIn, std::memory_order_relaxed);
+                m_SampleProbability[i].store(m_Properties.sampleRates[i].probability, std::memory_order_relaxed);
+                // A flight recorder wants every record, written or not.
+                m_LevelQueued[i].store(IsWritten(static_cast<Level>(i)) || m_Properties.flightRecorder,
+                                       std::memory_order_relaxed);
+            }
+
+            // Only republished when the ring or the default prefix changed.
+            const auto route = m_SharedRingRoute.Load(std::memory_order_relaxed);
+            if (route ? route->writer != m_SharedRing || route->defaultPrefix != m_Properties.defaultPrefix
+                      : m_SharedRing != nullptr)
+            {
+                m_SharedRingRoute.Store(m_SharedRing ? std::make_shared<const SharedRingRoute>(
+                                                           SharedRingRoute{ m_SharedRing, m_Properties.defaultPrefix })
+                                                     : nullptr,
+                                        std::memory_order_release);
+            }
+        }
+
+        // Must be called with m_Guard or m_WriteGuard held.
+        [[nodiscard]] auto IsWritten(const Level level) const noexcept -> bool
+        {
+            if (level == Level::Verbose && m_Properties.verbose)
+                return true;
+            return utils::SeverityRank(level) >= utils::SeverityRank(m_Properties.level);
+        }
+        // Whether a record at level is worth formatting at all, checked before anything else without taking m_Guard.
+        [[nodiscard]] auto IsQueued(const Level level) const noexcept -> bool
+        {
+            return m_LevelQueued[static_cast<std::size_t>(level)].load(std::memory_order_relaxed);
+        }
+
+        // Decides whether a sampled record should be kept, returning the rate to stamp on it if so.
+        // Runs before any formatting or queueing and never takes m_Guard.
+        [[nodiscard]] auto Sample(const Level level) const noexcept -> std::optional<float>
+        {
+            const auto index       = static_cast<std::size_t>(level);
+            const auto one_in      = m_SampleOneIn[index].load(std::memory_order_relaxed);
+            const auto probability = m_SampleProbability[index].load(std::memory_order_relaxed);
+
+            float rate = 1.0f;
+            if (one_in > 1)
+            {
+                // Counted per logger across all threads, so every logger keeps exactly 1 in N of its own records.
+                if ((m_SampleCounters[index].fetch_add(1, std::memory_order_relaxed) + 1) % one_in != 0)
+                    return std::nullopt;
+                rate *= static_cast<float>(one_in);
+            }
+            if (probability < 1.0f)
+            {
+                if (probability <= 0.0f)
+                    return std::nullopt;
+                // Compare the top 24 bits against p, exactly representable in a float.
+                if (static_cast<float>(utils::FastRandom() >> 40) * 0x1p-24f >= probability)
+                    return std::nullopt;
+                rate /= probability;
+            }
+            return rate;
+        }
+
     private:
         [[nodiscard]] static constexpr auto ContainsPlaceholder(const std::string_view format,
                                                                 const std::string_view placeholder) noexcept -> bool
@@ -217,185 +499,349 @@ namespace lgx {
     private:
         void PollLogs()
         {
-#ifdef __unix__
+            // Drain everything queued since the last wake-up as one batch so fd outputs get a single write.
+            // The batch and the queue are swapped back and forth so written slots are handed back to producers.
+            // m_Guard is only held for the swap, producers keep queueing while the batch is written. Progress through
+            // the batch is published so the crash handler can dump what has not been written yet.
+            std::unique_lock<std::mutex> guard{ m_Guard };
+            while (true)
             {
-                const std::lock_guard<std::mutex> lock{ m_Guard };
-                if (m_Properties.syslog)
+                m_PollCV.wait(guard, [this]() { return m_QueueSize > 0 || !m_Run; });
+                if (m_QueueSize == 0)
+                    break;
+                const bool stopping = !m_Run; // This batch is the last one.
+
+                m_Batch.swap(m_LogQueue);
+                const auto count = std::exchange(m_QueueSize, 0);
+                m_BatchBytes     = std::exchange(m_QueuedBytes, 0);
+                m_BatchWritten.store(0, std::memory_order_relaxed);
+                m_BatchSize.store(count, std::memory_order_release);
+                guard.unlock();
                 {
-                    int facility = LOG_USER;
-                    switch (m_Properties.appType)
+                    const std::lock_guard<std::mutex> write{ m_WriteGuard };
+
+                    // fd outputs only go out with the whole batch, so with any of them nothing counts as written
+                    // before FlushFdBatch and everything does right after it.
+                    const bool deferred = !m_Properties.outputFds.empty();
+                    for (std::size_t i = 0; i < count; ++i)
                     {
-                        case Type::User: facility = LOG_USER; break;
-                        case Type::Daemon: facility = LOG_DAEMON; break;
-                        default: break;
+                        // Record before InternalLog filters anything so Debug/Verbose context is kept.
+                        if (m_Properties.flightRecorder)
+                            m_Properties.flightRecorder->Record(m_Batch[i], m_Properties.defaultPrefix);
+                        InternalLog(m_Batch[i]);
+                        if (!deferred)
+                            m_BatchWritten.store(i + 1, std::memory_order_release);
                     }
-                    openlog(m_Properties.loggerName.c_str(), LOG_PID | LOG_CONS, facility);
+                    FlushFdBatch();
+                    m_BatchWritten.store(count, std::memory_order_release);
+                    if (m_Syslog)
+                        m_Syslog->Flush();
                 }
+                guard.lock();
+                m_BatchSize.store(0, std::memory_order_release);
+                m_BatchBytes = 0;
+                RecycleBatch(m_Batch, count);
+                if (stopping)
+                    break;
+            }
+        }
+
+    private:
+        // Keeps written slots for reuse within recordPoolBytes, releasing oversized or surplus ones. This only bounds
+        // what is retained between batches, maxQueuedBytes bounds what can be queued at once.
+        inline auto RecycleBatch(std::vector<LogMsg>& batch, const std::size_t count) const noexcept -> void
+        {
+            const auto block_size = std::max<std::size_t>(m_Properties.recordBlockSize, 1);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (batch[i].message.capacity() > block_size)
+                    batch[i].message = std::string{};
+                batch[i].context.reset();
             }
-#endif
 
-            while (m_Run)
+            // Half the cap each, since the queue and the batch both hold slots.
+            const auto max_slots = m_Properties.recordPoolBytes / (2 * block_size);
+            if (batch.size() > max_slots)
+                batch.erase(batch.begin() + static_cast<std::ptrdiff_t>(max_slots), batch.end());
+        }
+        // Copies the record into a recycled queue slot, reusing its buffers instead of allocating new ones.
+        // A missing style is resolved to the level's default here, a missing prefix means the logger's default
+        // prefix as of write time.
+        inline auto Enqueue(const Level level, const std::optional<std::string_view> prefix,
+                            const std::optional<fmt::text_style>& style, const std::string_view message,
+                            const ScopedContext::Snapshot& context, const float sampleRate = 1.0f,
+                            const std::optional<std::chrono::system_clock::time_point> time = std::nullopt) const
+            -> void
+        {
+            // In collector mode the record goes straight into shared memory without taking m_Guard, the collector
+            // process writes it out. The snapshot keeps the ring and the default prefix alive while it is copied.
+            if (const auto route = m_SharedRingRoute.Load(std::memory_order_acquire))
             {
-                std::unique_lock<std::mutex> guard{ m_Guard };
-                m_PollCV.wait(guard, [this]() { return !m_LogQueue.empty() || !m_Run; });
+                route->writer->Push(level, prefix.value_or(route->defaultPrefix),
+                                    context ? std::string_view{ *context } : std::string_view{}, message, sampleRate);
+                return;
+            }
 
-                if (!m_LogQueue.empty())
-                {
-                    auto log = m_LogQueue.front();
-                    m_LogQueue.pop_front();
-                    InternalLog(std::move(log));
-                }
+            const std::scoped_lock guard{ m_Guard };
+
+            // The queue and the batch being written are capped together. A logger whose sinks cannot keep up drops
+            // (and counts) new records once the cap is reached, it never blocks the caller or grows without bound.
+            const auto size = sizeof(LogMsg) + message.size() + (prefix ? prefix->size() : 0);
+            if (m_Properties.maxQueuedBytes != 0 && m_QueuedBytes + m_BatchBytes + size > m_Properties.maxQueuedBytes)
+            {
+                m_QueueDropped.fetch_add(1, std::memory_order_relaxed);
+                return;
             }
+            m_QueuedBytes += size;
 
-#ifdef __unix__
-            if (m_Properties.syslog)
-                closelog();
-#endif
+            if (m_QueueSize == m_LogQueue.size())
+                m_LogQueue.emplace_back().message.reserve(m_Properties.recordBlockSize);
+
+            auto& slot = m_LogQueue[m_QueueSize++];
+            slot.level = level;
+            slot.message.assign(message);
+            if (!prefix)
+                slot.prefix.reset();
+            else if (slot.prefix)
+                slot.prefix->assign(*prefix);
+            else
+                slot.prefix.emplace(*prefix);
+            slot.style      = style ? *style : DefaultStyleFromLevel(level);
+            slot.sampleRate = sampleRate;
+            slot.context    = context;
+            slot.time       = time;
+            m_PollCV.notify_one();
+        }
+        // Formats into a per-thread buffer that keeps its capacity, so steady-state logging does not allocate.
+        template <typename... TArgs>
+        [[nodiscard]] static auto FormatToThreadBuffer(const std::string_view fmt, TArgs&&... args) -> std::string_view
+        {
+            thread_local fmt::memory_buffer buffer;
+            buffer.clear();
+            fmt::format_to(std::back_inserter(buffer), fmt::runtime(fmt), std::forward<TArgs>(args)...);
+            return { buffer.data(), buffer.size() };
         }
 
     private:
-        inline auto InternalLog(const LogMsg& log) const -> void
+        inline auto FlushFdBatch() const noexcept -> void
         {
-#ifndef LGX_DEBUG
-            if (log.level == Level::Debug)
+            if (m_FdBatch.size() == 0)
                 return;
-#endif
 
-            if (log.level == Level::Verbose && !m_Properties.verbose)
+            for (const int fd : m_Properties.outputFds)
+                utils::WriteBatch(fd, { m_FdBatch.data(), m_FdBatch.size() });
+
+            // Keeps its capacity for the next batch, unless an unusually large one grew it past the pool's cap.
+            if (m_FdBatch.capacity() > m_Properties.recordPoolBytes)
+                m_FdBatch = fmt::memory_buffer{};
+            m_FdBatch.clear();
+        }
+
+    private:
+        inline auto InternalLog(const LogMsg& log) const -> void
+        {
+            if (!IsWritten(log.level))
                 return;
 
-            // Prepare arguments conditionally based on the presence of placeholders in the format string.
-            auto arg_store = fmt::dynamic_format_arg_store<fmt::format_context>{};
+            if (!ContainsPlaceholder(m_Properties.defaultStyle.format, "{msg}"))
+                throw std::invalid_argument("A message is always required.");
 
+            // Only pay for formatting the timestamp when the format asks for it.
+            const auto time_now = log.time.value_or(std::chrono::system_clock::now());
+            m_DateTime.clear();
             if (ContainsPlaceholder(m_Properties.defaultStyle.format, "{datetime}"))
             {
-                auto time_now = std::chrono::system_clock::now();
                 auto time_obj = std::chrono::system_clock::to_time_t(time_now);
-                arg_store.push_back(
-                    fmt::arg("datetime", fmt::format(fmt::runtime("{:" + m_Properties.dateTimeFormat + '}'),
-                                                     *std::localtime(&time_obj))));
+                m_DateTimeSpec.clear();
+                fmt::format_to(std::back_inserter(m_DateTimeSpec), "{{:{}}}", m_Properties.dateTimeFormat);
+                fmt::format_to(std::back_inserter(m_DateTime),
+                               fmt::runtime(std::string_view{ m_DateTimeSpec.data(), m_DateTimeSpec.size() }),
+                               utils::LocalTime(time_obj));
             }
-            if (ContainsPlaceholder(m_Properties.defaultStyle.format, "{level}"))
-                arg_store.push_back(fmt::arg("level", log.level));
-            if (ContainsPlaceholder(m_Properties.defaultStyle.format, "{prefix}"))
-                arg_store.push_back(fmt::arg("prefix", log.prefix.value_or(m_Properties.defaultPrefix)));
-            if (!ContainsPlaceholder(m_Properties.defaultStyle.format, "{msg}"))
-                throw std::invalid_argument("A message is always required.");
 
-            // Always push the message argument
-            arg_store.push_back(fmt::arg("msg", log.message));
+            // Static named arguments referencing the record, unused ones are ignored by fmt.
+            // fmt::arg only keeps a reference, so the views have to outlive the call.
+            const auto datetime     = std::string_view{ m_DateTime.data(), m_DateTime.size() };
+            const auto prefix       = log.prefix ? std::string_view{ *log.prefix } : m_Properties.defaultPrefix;
+            const auto context      = log.context ? std::string_view{ *log.context } : std::string_view{};
+            const auto message      = std::string_view{ log.message };
+            const auto datetime_arg = fmt::arg("datetime", datetime);
+            const auto level_arg    = fmt::arg("level", log.level);
+            const auto prefix_arg   = fmt::arg("prefix", prefix);
+            const auto context_arg  = fmt::arg("context", context);
+            const auto sample_arg   = fmt::arg("sample_rate", log.sampleRate);
+            const auto msg_arg      = fmt::arg("msg", message);
+
+            // Format the unstyled line once, styles are applied around it with cached escape sequences.
+            m_Line.clear();
+            fmt::vformat_to(
+                std::back_inserter(m_Line), m_Properties.defaultStyle.format,
+                fmt::make_format_args(datetime_arg, level_arg, prefix_arg, context_arg, sample_arg, msg_arg));
+            const auto line = std::string_view{ m_Line.data(), m_Line.size() };
+
+            const StyleCache::Escapes* escapes = nullptr;
+            const auto                 styled  = [&]() -> const StyleCache::Escapes&
+            {
+                if (!escapes)
+                    escapes = &m_StyleCache.Get(log.style, log.level, DefaultStyleFromLevel(log.level));
+                return *escapes;
+            };
 
             for (const auto& stream : m_Properties.outputStreams)
             {
                 if (stream == &std::cout)
                 {
-                    std::cout << fmt::vformat(log.style, m_Properties.defaultStyle.format, arg_store) << std::endl;
+                    if (m_Properties.styleOnlyOnTerminal && !utils::IsStdoutTerminal())
+                        std::cout << line << std::endl;
+                    else
+                        std::cout << styled().prefix << line << styled().suffix << std::endl;
                 }
                 else
                 {
                     if (m_Properties.serializeToNonStdoutStreams)
                         *stream << LogMsg::ToString(log) << std::endl;
                     else if (m_Properties.writeStyleToNonStdoutStreams)
-                        *stream << fmt::vformat(log.style, m_Properties.defaultStyle.format, arg_store) << std::endl;
+                        *stream << styled().prefix << line << styled().suffix << std::endl;
                     else
-                        *stream << fmt::vformat(m_Properties.defaultStyle.format, arg_store) << std::endl;
+                        *stream << line << std::endl;
                 }
             }
 
-#ifdef __unix__
-            if (m_Properties.syslog)
+            if (!m_Properties.outputFds.empty())
             {
-                std::string syslog_fmt = "{msg}";
-
-                // Prepare arguments conditionally based on the presence of placeholders in the format string.
-                auto arg_store = fmt::dynamic_format_arg_store<fmt::format_context>{};
-
-                if (ContainsPlaceholder(m_Properties.defaultStyle.format, "{prefix}"))
-                {
-                    syslog_fmt = "[{prefix}] " + syslog_fmt;
-                    arg_store.push_back(fmt::arg("prefix", log.prefix.value_or(m_Properties.defaultPrefix)));
-                }
-                if (!ContainsPlaceholder(m_Properties.defaultStyle.format, "{msg}"))
-                    throw std::invalid_argument("A message is always required.");
-
-                // Always push the message argument
-                arg_store.push_back(fmt::arg("msg", log.message));
-
-                int level = LOG_INFO;
-                switch (log.level)
-                {
-                    using enum Level;
-
-                    case Info: level = LOG_INFO; break;
-                    case Warn: level = LOG_WARNING; break;
-                    case Error: level = LOG_ERR; break;
-                    case Fatal: level = LOG_ALERT; break;
-                    case Debug:
-                    case Verbose: level = LOG_DEBUG; break;
-                }
-
-                std::string strlogmsg;
-                if (m_Properties.writeStyleToNonStdoutStreams)
-                    strlogmsg = fmt::vformat(log.style, syslog_fmt, arg_store);
+                const auto out = std::back_inserter(m_FdBatch);
+                if (m_Properties.serializeToNonStdoutStreams)
+                    fmt::format_to(out, "{}\n", LogMsg::ToString(log));
+                else if (m_Properties.writeStyleToNonStdoutStreams)
+                    fmt::format_to(out, "{}{}{}\n", styled().prefix, line, styled().suffix);
                 else
-                    strlogmsg = fmt::vformat(syslog_fmt, arg_store);
+                    fmt::format_to(out, "{}\n", line);
+            }
 
-                syslog(level, "%s", strlogmsg.c_str());
+            if (m_Properties.syslog)
+            {
+                if (!m_Syslog)
+                    m_Syslog = std::make_unique<SyslogSink>(m_Properties.loggerName, m_Properties.appType,
+                                                            m_Properties.syslogSocketPath);
+                const auto& format = m_Properties.defaultStyle.format;
+                m_Syslog->Append(log.level, ContainsPlaceholder(format, "{prefix}") ? prefix : std::string_view{},
+                                 ContainsPlaceholder(format, "{context}") ? context : std::string_view{}, message,
+                                 time_now);
             }
-#endif
         }
 
+    public:
+        // Writes every record not written out yet, the poll thread's unfinished batch and then the queue, to fd as
+        // "[level] (prefix) {context}: message" lines without taking m_Guard or allocating.
+        // Only meant to be called from the crash handler, the queue may be mid-update when it runs.
+        auto DumpPending(int fd) const noexcept -> void;
+
     public:
         Logger& Swap(Logger& other) noexcept
         {
             if (this != &other)
             {
-                const std::lock_guard<std::mutex> lock0{ m_Guard };
-                const std::lock_guard<std::mutex> lock1{ other.m_Guard };
+                {
+                    // Each poll thread stays with its own logger, only what they read is exchanged.
+                    const std::scoped_lock lock{ m_WriteGuard, m_Guard, other.m_WriteGuard, other.m_Guard };
 
-                std::swap(m_Properties, other.m_Properties);
-                std::swap(m_Run, other.m_Run);
-                std::swap(m_LogQueue, other.m_LogQueue);
+                    std::swap(m_Properties, other.m_Properties);
+                    std::swap(m_LogQueue, other.m_LogQueue);
+                    std::swap(m_QueueSize, other.m_QueueSize);
+                    std::swap(m_QueuedBytes, other.m_QueuedBytes);
+                    std::swap(m_Syslog, other.m_Syslog);
+                    std::swap(m_SharedRing, other.m_SharedRing);
+                    SyncLockFreeState();
+                    other.SyncLockFreeState();
+                }
+                // A poll thread waiting on an empty queue would not notice the records it was just handed.
+                m_PollCV.notify_one();
+                other.m_PollCV.notify_one();
             }
             return *this;
         }
-        inline auto Log(LogMsg log) const -> void
+        inline auto Log(const LogMsg& log) const -> void
         {
-            const std::scoped_lock guard{ m_Guard };
-            m_LogQueue.push_back(std::move(log));
-            m_PollCV.notify_one();
+            if (!IsQueued(log.level))
+                return;
+
+            // Records built elsewhere (e.g. by the collector) keep their own context and time.
+            Enqueue(log.level, log.prefix, log.style, log.message, log.context ? log.context : ScopedContext::Current(),
+                    log.sampleRate, log.time);
         }
         template <typename... TArgs>
-        constexpr auto Log(std::string prefix, const Level level, const fmt::text_style& style,
+        constexpr auto Log(const std::string_view prefix, const Level level, const fmt::text_style& style,
                            const std::string_view fmt, TArgs&&... args) const -> void
         {
-            Log(LogMsg{ .level   = level,
-                        .message = fmt::format(fmt::runtime(fmt), std::forward<TArgs>(args)...),
-                        .prefix  = std::move(prefix),
-                        .style   = style });
+            if (!IsQueued(level))
+                return;
+
+            Enqueue(level, prefix, style, FormatToThreadBuffer(fmt, std::forward<TArgs>(args)...),
+                    ScopedContext::Current());
         }
         template <typename... TArgs>
         constexpr auto Log(LogMsg log, const std::string_view fmt, TArgs&&... args) const -> void
         {
-            Log(log.prefix.value_or(m_Properties.defaultPrefix), log.level, log.style, fmt,
-                std::forward<TArgs>(args)...);
+            if (!IsQueued(log.level))
+                return;
+
+            Enqueue(log.level, log.prefix, log.style, FormatToThreadBuffer(fmt, std::forward<TArgs>(args)...),
+                    ScopedContext::Current());
         }
         template <typename... TArgs>
         constexpr auto Log(const Level level, const std::string_view fmt, TArgs&&... args) const -> void
         {
-            Log(m_Properties.defaultPrefix, level, DefaultStyleFromLevel(level), fmt, std::forward<TArgs>(args)...);
+            if (!IsQueued(level))
+                return;
+
+            Enqueue(level, std::nullopt, std::nullopt, FormatToThreadBuffer(fmt, std::forward<TArgs>(args)...),
+                    ScopedContext::Current());
         }
         template <typename... TArgs>
-        constexpr auto Log(const std::string prefix, const Level level, const std::string_view fmt,
+        constexpr auto Log(const std::string_view prefix, const Level level, const std::string_view fmt,
                            TArgs&&... args) const -> void
         {
-            Log(std::move(prefix), level, DefaultStyleFromLevel(level), fmt, std::forward<TArgs>(args)...);
+            if (!IsQueued(level))
+                return;
+
+            Enqueue(level, prefix, std::nullopt, FormatToThreadBuffer(fmt, std::forward<TArgs>(args)...),
+                    ScopedContext::Current());
         }
         template <typename... TArgs>
         constexpr auto Log(const Level level, const fmt::text_style& style, const std::string_view fmt,
                            TArgs&&... args) const -> void
         {
-            Log(m_Properties.defaultPrefix, level, style, fmt, std::forward<TArgs>(args)...);
+            if (!IsQueued(level))
+                return;
+
+            Enqueue(level, std::nullopt, style, FormatToThreadBuffer(fmt, std::forward<TArgs>(args)...),
+                    ScopedContext::Current());
+        }
+
+        template <typename... TArgs>
+        auto LogSampled(const std::string_view prefix, const Level level, const std::string_view fmt,
+                        TArgs&&... args) const -> void
+        {
+            if (!IsQueued(level))
+                return;
+            const auto rate = Sample(level);
+            if (!rate)
+                return;
+
+            Enqueue(level, prefix, std::nullopt, FormatToThreadBuffer(fmt, std::forward<TArgs>(args)...),
+                    ScopedContext::Current(), *rate);
+        }
+        template <typename... TArgs>
+        auto LogSampled(const Level level, const std::string_view fmt, TArgs&&... args) const -> void
+        {
+            if (!IsQueued(level))
+                return;
+            const auto rate = Sample(level);
+            if (!rate)
+                return;
+
+            Enqueue(level, std::nullopt, std::nullopt, FormatToThreadBuffer(fmt, std::forward<TArgs>(args)...),
+                    ScopedContext::Current(), *rate);
         }
 
     public:
@@ -429,129 +875,196 @@ namespace lgx {
         {
             Log(Level::Verbose, fmt, std::forward<TArgs>(args)...);
         }
+        template <typename... TArgs>
+        auto InfoSampled(const std::string_view fmt, TArgs&&... args) const -> void
+        {
+            LogSampled(Level::Info, fmt, std::forward<TArgs>(args)...);
+        }
+        template <typename... TArgs>
+        auto WarnSampled(const std::string_view fmt, TArgs&&... args) const -> void
+        {
+            LogSampled(Level::Warn, fmt, std::forward<TArgs>(args)...);
+        }
+        template <typename... TArgs>
+        auto ErrorSampled(const std::string_view fmt, TArgs&&... args) const -> void
+        {
+            LogSampled(Level::Error, fmt, std::forward<TArgs>(args)...);
+        }
+        template <typename... TArgs>
+        auto FatalSampled(const std::string_view fmt, TArgs&&... args) const -> void
+        {
+            LogSampled(Level::Fatal, fmt, std::forward<TArgs>(args)...);
+        }
+        template <typename... TArgs>
+        auto DebugSampled(const std::string_view fmt, TArgs&&... args) const -> void
+        {
+            LogSampled(Level::Debug, fmt, std::forward<TArgs>(args)...);
+        }
+        template <typename... TArgs>
+        auto VerboseSampled(const std::string_view fmt, TArgs&&... args) const -> void
+        {
+            LogSampled(Level::Verbose, fmt, std::forward<TArgs>(args)...);
+        }
     };
 
     [[nodiscard]] auto Get(const std::string& loggerName) -> Logger&;
 
+    // The "global" logger, looked up in the registry only once. Registry entries are never erased and
+    // std::unordered_map keeps references stable, so lgx::Log skips the hashing and locking of Get.
+    [[nodiscard]] inline auto GetGlobal() -> Logger&
+    {
+        static Logger& global = Get("global");
+        return global;
+    }
+
     [[nodiscard]] inline auto GetDefaultPrefix() noexcept
     {
-        return Get("global").GetDefaultPrefix();
+        return GetGlobal().GetDefaultPrefix();
     }
 
     [[nodiscard]] inline auto GetDateTimeFormat() noexcept
     {
-        return Get("global").GetDateTimeFormat();
+        return GetGlobal().GetDateTimeFormat();
     }
 
     [[nodiscard]] inline auto GetFormat() noexcept -> std::string
     {
-        return Get("global").GetFormat();
+        return GetGlobal().GetFormat();
     }
 
     [[nodiscard]] inline auto GetDefaultInfoStyle() noexcept
     {
-        return Get("global").GetDefaultInfoStyle();
+        return GetGlobal().GetDefaultInfoStyle();
     }
 
     [[nodiscard]] inline auto GetDefaultWarnStyle() noexcept
     {
-        return Get("global").GetDefaultWarnStyle();
+        return GetGlobal().GetDefaultWarnStyle();
     }
 
     [[nodiscard]] inline auto GetDefaultErrorStyle() noexcept
     {
-        return Get("global").GetDefaultErrorStyle();
+        return GetGlobal().GetDefaultErrorStyle();
     }
 
     [[nodiscard]] inline auto GetDefaultFatalStyle() noexcept
     {
-        return Get("global").GetDefaultFatalStyle();
+        return GetGlobal().GetDefaultFatalStyle();
     }
 
     [[nodiscard]] inline auto GetDefaultDebugStyle() noexcept
     {
-        return Get("global").GetDefaultDebugStyle();
+        return GetGlobal().GetDefaultDebugStyle();
+    }
+
+    [[nodiscard]] inline auto GetLevel() noexcept -> Level
+    {
+        return GetGlobal().GetLevel();
+    }
+
+    inline void SetLevel(const Level level) noexcept
+    {
+        GetGlobal().SetLevel(level);
     }
 
     inline void SetDefaultPrefix(const std::string_view newDefaultPrefix) noexcept
     {
-        Get("global").SetDefaultPrefix(newDefaultPrefix);
+        GetGlobal().SetDefaultPrefix(newDefaultPrefix);
     }
 
     inline void SetDateTimeFormat(const std::string_view newDateTimeFormat) noexcept
     {
-        Get("global").SetDateTimeFormat(newDateTimeFormat);
+        GetGlobal().SetDateTimeFormat(newDateTimeFormat);
     }
 
     inline void SetFormat(const std::string_view newFormat) noexcept
     {
-        Get("global").SetFormat(newFormat);
+        GetGlobal().SetFormat(newFormat);
     }
 
     inline void SetDefaultInfoStyle(const fmt::text_style& style) noexcept
     {
-        Get("global").SetDefaultInfoStyle(style);
+        GetGlobal().SetDefaultInfoStyle(style);
     }
 
     inline void SetDefaultWarnStyle(const fmt::text_style& style) noexcept
     {
-        Get("global").SetDefaultWarnStyle(style);
+        GetGlobal().SetDefaultWarnStyle(style);
     }
 
     inline void SetDefaultErrorStyle(const fmt::text_style& style) noexcept
     {
-        Get("global").SetDefaultErrorStyle(style);
+        GetGlobal().SetDefaultErrorStyle(style);
     }
 
     inline void SetDefaultFatalStyle(const fmt::text_style& style) noexcept
     {
-        Get("global").SetDefaultFatalStyle(style);
+        GetGlobal().SetDefaultFatalStyle(style);
     }
 
     inline void SetDefaultDebugStyle(const fmt::text_style& style) noexcept
     {
-        Get("global").SetDefaultDebugStyle(style);
+        GetGlobal().SetDefaultDebugStyle(style);
     }
 
     inline void SetDefaultVerboseStyle(const fmt::text_style& style) noexcept
     {
-        Get("global").SetDefaultVerboseStyle(style);
+        GetGlobal().SetDefaultVerboseStyle(style);
     }
 
     inline auto Log(const LogMsg& log) -> void
     {
-        Get("global").Log(log);
+        GetGlobal().Log(log);
     }
 
     template <typename... TArgs>
     inline auto Log(const std::string_view prefix, const Level level, const fmt::text_style& style,
                     const std::string_view fmt, TArgs&&... args) -> void
     {
-        Get("global").Log(prefix, level, style, fmt, std::forward<TArgs>(args)...);
+        GetGlobal().Log(prefix, level, style, fmt, std::forward<TArgs>(args)...);
     }
 
     template <typename... TArgs>
     inline auto Log(const LogMsg& log, const std::string_view fmt, TArgs&&... args) -> void
     {
-        Get("global").Log(log, fmt, std::forward<TArgs>(args)...);
+        GetGlobal().Log(log, fmt, std::forward<TArgs>(args)...);
     }
 
     template <typename... TArgs>
     inline auto Log(const Level level, const std::string_view fmt, TArgs&&... args) -> void
     {
-        Get("global").Log(level, fmt, std::forward<TArgs>(args)...);
+        GetGlobal().Log(level, fmt, std::forward<TArgs>(args)...);
     }
 
     template <typename... TArgs>
     inline auto Log(const std::string_view prefix, const Level level, const std::string_view fmt, TArgs&&... args)
         -> void
     {
-        Get("global").Log(prefix, level, fmt, std::forward<TArgs>(args)...);
+        GetGlobal().Log(prefix, level, fmt, std::forward<TArgs>(args)...);
     }
 
     template <typename... TArgs>
     auto Log(const Level level, const fmt::text_style& style, const std::string_view fmt, TArgs&&... args) -> void
     {
-        Get("global").Log(level, style, fmt, std::forward<TArgs>(args)...);
+        GetGlobal().Log(level, style, fmt, std::forward<TArgs>(args)...);
+    }
+
+    template <typename... TArgs>
+    inline auto LogSampled(const Level level, const std::string_view fmt, TArgs&&... args) -> void
+    {
+        GetGlobal().LogSampled(level, fmt, std::forward<TArgs>(args)...);
+    }
+
+    template <typename... TArgs>
+    inline auto LogSampled(const std::string_view prefix, const Level level, const std::string_view fmt,
+                           TArgs&&... args) -> void
+    {
+        GetGlobal().LogSampled(prefix, level, fmt, std::forward<TArgs>(args)...);
     }
 } // namespace lgx
+
+#ifdef LGX_HEADER_ONLY
+// Both need the complete Logger, so they are pulled in here rather than from CrashHandler.h.
+#include "CrashHandler.cpp"
+#include "Logger.cpp"
+#endif
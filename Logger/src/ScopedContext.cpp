@@ -0,0 +1,33 @@
+#include "ScopedContext.h"
+
+namespace lgx {
+    // One snapshot per active scope, each holding the rendering of itself and every scope below it.
+    [[nodiscard]] LGX_INTERNAL auto ThreadSnapshots() noexcept -> std::vector<ScopedContext::Snapshot>&
+    {
+        thread_local std::vector<ScopedContext::Snapshot> snapshots;
+        return snapshots;
+    }
+
+    LGX_INLINE ScopedContext::~ScopedContext() noexcept
+    {
+        auto& snapshots = ThreadSnapshots();
+        if (!snapshots.empty())
+            snapshots.pop_back();
+    }
+
+    LGX_INLINE auto ScopedContext::Push(const std::string_view key, const std::string_view value) -> void
+    {
+        auto&       snapshots = ThreadSnapshots();
+        std::string rendered  = snapshots.empty() ? std::string{} : *snapshots.back() + ' ';
+        fmt::format_to(std::back_inserter(rendered), "{}={}", key, value);
+        snapshots.push_back(std::make_shared<const std::string>(std::move(rendered)));
+    }
+
+    LGX_INLINE auto ScopedContext::Current() noexcept -> const Snapshot&
+    {
+        static const Snapshot c_Empty;
+
+        const auto& snapshots = ThreadSnapshots();
+        return snapshots.empty() ? c_Empty : snapshots.back();
+    }
+} // namespace lgx
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Common.h"
+
+namespace lgx {
+    // Key/value fields attached to every record logged from the current thread while the scope is alive, rendered
+    // through the {context} placeholder as "key=value key=value". Scopes nest and must be destroyed in reverse order
+    // on the thread that created them, which is what declaring them as locals gives you:
+    //
+    //     lgx::ScopedContext request{ "req_id", id };
+    //     logger.Info("Handling request."); // {context} -> "req_id=42"
+    //
+    // The value is formatted once here. Each scope publishes an immutable snapshot of the whole rendered context,
+    // records only take a reference to it, so logging never re-stringifies or copies the fields.
+    class ScopedContext
+    {
+    public:
+        using Snapshot = std::shared_ptr<const std::string>;
+
+    public:
+        template <typename T>
+        ScopedContext(const std::string_view key, const T& value)
+        {
+            Push(key, fmt::format("{}", value));
+        }
+        ~ScopedContext() noexcept;
+        ScopedContext(const ScopedContext&)            = delete;
+        ScopedContext& operator=(const ScopedContext&) = delete;
+
+    private:
+        static auto Push(std::string_view key, std::string_view value) -> void;
+
+    public:
+        // The calling thread's rendered context, null when no scope is active.
+        [[nodiscard]] static auto Current() noexcept -> const Snapshot&;
+    };
+} // namespace lgx
+
+#ifdef LGX_HEADER_ONLY
+#include "ScopedContext.cpp"
+#endif
@@ -0,0 +1,266 @@
+#include "SharedRing.h"
+
+#include <bit>
+#include <new>
+
+#ifdef __unix__
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lgx {
+    namespace shm {
+        [[nodiscard]] LGX_INTERNAL constexpr auto RoundUp(const std::size_t value, const std::size_t alignment) noexcept
+            -> std::size_t
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        LGX_INTERNAL constexpr std::size_t c_HeaderSize = RoundUp(sizeof(RingHeader), 64);
+
+        [[nodiscard]] LGX_INTERNAL auto SlotAt(std::byte* slots, const RingHeader& header,
+                                               const std::uint64_t position) noexcept -> SlotHeader*
+        {
+            return reinterpret_cast<SlotHeader*>(slots + (position & (header.slotCount - 1)) * header.slotStride);
+        }
+    } // namespace shm
+
+    LGX_INLINE SharedRingWriter::SharedRingWriter(const std::string_view ring, const std::size_t slotCount,
+                                                  const std::size_t slotSize)
+    {
+#ifdef __unix__
+        static std::atomic<std::uint32_t> next_index = 0;
+
+        const auto count  = std::bit_ceil(std::max<std::size_t>(slotCount, 2));
+        const auto stride = shm::RoundUp(sizeof(shm::SlotHeader) + slotSize, 64);
+        const auto name   = shm::SegmentName(ring, ::getpid(), next_index.fetch_add(1, std::memory_order_relaxed));
+        const auto size   = shm::c_HeaderSize + count * stride;
+
+        // A leftover segment can only belong to a dead process that had our pid, reclaim it.
+        ::shm_unlink(name.c_str());
+        const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+            return;
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return;
+        }
+
+        void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED)
+        {
+            ::shm_unlink(name.c_str());
+            return;
+        }
+
+        m_MappedSize  = size;
+        m_PayloadSize = stride - sizeof(shm::SlotHeader);
+        m_Header      = new (memory) shm::RingHeader{};
+        m_Slots       = static_cast<std::byte*>(memory) + shm::c_HeaderSize;
+
+        m_Header->version    = shm::Version;
+        m_Header->slotCount  = static_cast<std::uint32_t>(count);
+        m_Header->slotStride = static_cast<std::uint32_t>(stride);
+        m_Header->pid        = static_cast<std::int32_t>(::getpid());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto* slot = new (m_Slots + i * stride) shm::SlotHeader{};
+            slot->sequence.store(i, std::memory_order_relaxed);
+        }
+
+        // Publishing the magic last tells the collector the segment is fully initialised.
+        std::atomic_ref<std::uint32_t>{ m_Header->magic }.store(shm::Magic, std::memory_order_release);
+#else
+        (void)ring;
+        (void)slotCount;
+        (void)slotSize;
+#endif
+    }
+
+    LGX_INLINE SharedRingWriter::~SharedRingWriter() noexcept
+    {
+#ifdef __unix__
+        if (m_Header)
+        {
+            m_Header->closed.store(1, std::memory_order_release);
+            ::munmap(m_Header, m_MappedSize);
+        }
+#endif
+    }
+
+    LGX_INLINE auto SharedRingWriter::Push(const Level level, const std::string_view prefix,
+                                           const std::string_view context, const std::string_view message,
+                                           const float sampleRate) noexcept -> bool
+    {
+        if (!m_Header)
+            return false;
+
+        // Bounded MPMC queue scheme: a slot is free for position p when its sequence equals p.
+        auto             position = m_Header->head.load(std::memory_order_relaxed);
+        shm::SlotHeader* slot     = nullptr;
+        while (true)
+        {
+            slot             = shm::SlotAt(m_Slots, *m_Header, position);
+            const auto delta = static_cast<std::int64_t>(slot->sequence.load(std::memory_order_acquire) - position);
+            if (delta == 0)
+            {
+                if (m_Header->head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (delta < 0)
+            {
+                m_Header->dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+                position = m_Header->head.load(std::memory_order_relaxed);
+        }
+
+        const auto prefix_size  = std::min({ prefix.size(), m_PayloadSize, std::size_t{ UINT16_MAX } });
+        const auto context_size = std::min({ context.size(), m_PayloadSize - prefix_size, std::size_t{ UINT16_MAX } });
+        const auto message_size = std::min(message.size(), m_PayloadSize - prefix_size - context_size);
+        auto*      payload      = reinterpret_cast<std::byte*>(slot) + sizeof(shm::SlotHeader);
+
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        slot->timestamp   = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+        slot->level       = level;
+        slot->sampleRate  = sampleRate;
+        slot->prefixSize  = static_cast<std::uint16_t>(prefix_size);
+        slot->contextSize = static_cast<std::uint16_t>(context_size);
+        slot->messageSize = static_cast<std::uint32_t>(message_size);
+        std::memcpy(payload, prefix.data(), prefix_size);
+        std::memcpy(payload + prefix_size, context.data(), context_size);
+        std::memcpy(payload + prefix_size + context_size, message.data(), message_size);
+
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    LGX_INLINE SharedRingReader::SharedRingReader(std::string name)
+        : m_Name(std::move(name))
+    {
+#ifdef __unix__
+        const int fd = ::shm_open(m_Name.c_str(), O_RDWR, 0);
+        if (fd < 0)
+            return;
+
+        struct stat info = {};
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < shm::c_HeaderSize)
+        {
+            ::close(fd);
+            return;
+        }
+
+        const auto size   = static_cast<std::size_t>(info.st_size);
+        void*      memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED)
+            return;
+
+        auto* header = static_cast<shm::RingHeader*>(memory);
+        if (std::atomic_ref<std::uint32_t>{ header->magic }.load(std::memory_order_acquire) != shm::Magic ||
+            header->version != shm::Version || !std::has_single_bit(header->slotCount) ||
+            shm::c_HeaderSize + std::size_t{ header->slotCount } * header->slotStride != size)
+        {
+            // Not (yet) a valid ring, discovery will try again later.
+            ::munmap(memory, size);
+            return;
+        }
+
+        m_Header     = header;
+        m_Slots      = static_cast<std::byte*>(memory) + shm::c_HeaderSize;
+        m_MappedSize = size;
+#endif
+    }
+
+    LGX_INLINE SharedRingReader::~SharedRingReader() noexcept
+    {
+#ifdef __unix__
+        if (m_Header)
+            ::munmap(m_Header, m_MappedSize);
+#endif
+    }
+
+    LGX_INLINE auto SharedRingReader::GetDroppedCount() const noexcept -> std::uint64_t
+    {
+        return m_Header ? m_Header->dropped.load(std::memory_order_relaxed) : 0;
+    }
+
+    LGX_INLINE auto SharedRingReader::IsWriterGone() const noexcept -> bool
+    {
+        if (!m_Header)
+            return true;
+        if (m_Header->closed.load(std::memory_order_acquire) != 0)
+            return true;
+#ifdef __unix__
+        return ::kill(m_Header->pid, 0) != 0 && errno == ESRCH;
+#else
+        return false;
+#endif
+    }
+
+    LGX_INLINE auto SharedRingReader::Drain(std::vector<shm::Record>& out) -> std::size_t
+    {
+        if (!m_Header)
+            return 0;
+
+        const auto  payload_size = m_Header->slotStride - sizeof(shm::SlotHeader);
+        auto        position     = m_Header->tail.load(std::memory_order_relaxed);
+        std::size_t read         = 0;
+        while (true)
+        {
+            auto* slot = shm::SlotAt(m_Slots, *m_Header, position);
+            if (slot->sequence.load(std::memory_order_acquire) != position + 1)
+                break;
+
+            const auto  prefix_size  = std::min<std::size_t>(slot->prefixSize, payload_size);
+            const auto  context_size = std::min<std::size_t>(slot->contextSize, payload_size - prefix_size);
+            const auto  header_size  = prefix_size + context_size;
+            const auto  message_size = std::min<std::size_t>(slot->messageSize, payload_size - header_size);
+            const auto* payload      = reinterpret_cast<const char*>(slot) + sizeof(shm::SlotHeader);
+            out.push_back(shm::Record{ .timestamp  = slot->timestamp,
+                                       .pid        = m_Header->pid,
+                                       .level      = slot->level,
+                                       .sampleRate = slot->sampleRate,
+                                       .prefix     = std::string{ payload, prefix_size },
+                                       .context    = std::string{ payload + prefix_size, context_size },
+                                       .message    = std::string{ payload + header_size, message_size } });
+
+            // Hand the slot back to producers for the next lap around the ring.
+            slot->sequence.store(position + m_Header->slotCount, std::memory_order_release);
+            ++position;
+            ++read;
+        }
+        m_Header->tail.store(position, std::memory_order_relaxed);
+        return read;
+    }
+
+    LGX_INLINE auto SharedRingReader::Unlink() noexcept -> void
+    {
+#ifdef __unix__
+        ::shm_unlink(m_Name.c_str());
+#endif
+    }
+
+    LGX_INLINE auto SharedRingReader::Discover(const std::string_view ring) -> std::vector<std::string>
+    {
+        std::vector<std::string> names;
+        const auto               prefix = fmt::format("{}{}.", shm::NamePrefix, ring);
+
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator{ "/dev/shm", error })
+        {
+            const auto filename = entry.path().filename().string();
+            if (filename.starts_with(prefix))
+                names.push_back('/' + filename);
+        }
+        return names;
+    }
+} // namespace lgx
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Common.h"
+
+namespace lgx {
+    // Lock-free multi-producer ring of fixed-size record slots living in POSIX shared memory, used to hand records
+    // from worker processes to a single collector process (see Collector/). Producers only reserve a slot with a CAS
+    // and memcpy into it, a full ring drops the record and counts it instead of blocking.
+    //
+    // Segments are named "/lgx.<ring>.<pid>.<n>", n counting writers within the process. The writer never unlinks
+    // its segment, the collector does once the writer has closed it (or died) and everything has been drained.
+    namespace shm {
+        inline constexpr std::uint32_t    Magic      = 0x4C475852; // "LGXR"
+        inline constexpr std::uint32_t    Version    = 2;
+        inline constexpr std::string_view NamePrefix = "lgx.";
+
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                      "Shared memory rings need address-free 64-bit atomics.");
+
+        struct RingHeader
+        {
+            std::uint32_t              magic;
+            std::uint32_t              version;
+            std::uint32_t              slotCount; // Power of two.
+            std::uint32_t              slotStride;
+            std::int32_t               pid;
+            std::atomic<std::uint32_t> closed;
+            std::atomic<std::uint64_t> dropped;
+
+            alignas(64) std::atomic<std::uint64_t> head; // Next position producers reserve.
+            alignas(64) std::atomic<std::uint64_t> tail; // Next position the collector reads.
+        };
+
+        struct SlotHeader
+        {
+            std::atomic<std::uint64_t> sequence;
+            std::int64_t               timestamp; // Nanoseconds since the system_clock epoch.
+            float                      sampleRate;
+            std::uint32_t              messageSize;
+            std::uint16_t              prefixSize;
+            std::uint16_t              contextSize;
+            Level                      level;
+        };
+
+        struct Record
+        {
+            std::int64_t timestamp;
+            std::int32_t pid;
+            Level        level;
+            float        sampleRate;
+            std::string  prefix;
+            std::string  context;
+            std::string  message;
+        };
+
+        [[nodiscard]] inline auto SegmentName(const std::string_view ring, const std::int64_t pid,
+                                              const std::uint32_t index) -> std::string
+        {
+            return fmt::format("/{}{}.{}.{}", NamePrefix, ring, pid, index);
+        }
+    } // namespace shm
+
+    class SharedRingWriter
+    {
+    private:
+        shm::RingHeader* m_Header      = nullptr;
+        std::byte*       m_Slots       = nullptr;
+        std::size_t      m_MappedSize  = 0;
+        std::size_t      m_PayloadSize = 0;
+
+    public:
+        // Creates (or recreates) this process's segment for the ring. slotSize is the payload capacity per record,
+        // longer prefixes, contexts and messages are truncated.
+        SharedRingWriter(std::string_view ring, std::size_t slotCount, std::size_t slotSize);
+        ~SharedRingWriter() noexcept;
+        SharedRingWriter(const SharedRingWriter&)            = delete;
+        SharedRingWriter& operator=(const SharedRingWriter&) = delete;
+
+    public:
+        [[nodiscard]] inline auto IsOpen() const noexcept -> bool { return m_Header != nullptr; }
+
+    public:
+        // Returns false when the ring is full, counting a drop the collector reports, or not open.
+        auto Push(Level level, std::string_view prefix, std::string_view context, std::string_view message,
+                  float sampleRate) noexcept -> bool;
+    };
+
+    class SharedRingReader
+    {
+    private:
+        std::string      m_Name;
+        shm::RingHeader* m_Header     = nullptr;
+        std::byte*       m_Slots      = nullptr;
+        std::size_t      m_MappedSize = 0;
+
+    public:
+        explicit SharedRingReader(std::string name);
+        ~SharedRingReader() noexcept;
+        SharedRingReader(const SharedRingReader&)            = delete;
+        SharedRingReader& operator=(const SharedRingReader&) = delete;
+
+    public:
+        [[nodiscard]] inline auto IsOpen() const noexcept -> bool { return m_Header != nullptr; }
+        [[nodiscard]] inline auto GetName() const noexcept -> const std::string& { return m_Name; }
+        [[nodiscard]] auto GetDroppedCount() const noexcept -> std::uint64_t;
+        // True once the writer closed the ring or its process is gone.
+        [[nodiscard]] auto IsWriterGone() const noexcept -> bool;
+
+    public:
+        // Appends every committed record to out, returning how many were read.
+        auto Drain(std::vector<shm::Record>& out) -> std::size_t;
+        // Removes the segment name, the mapping stays valid until the reader is destroyed.
+        auto Unlink() noexcept -> void;
+
+    public:
+        // Lists the segment names currently present for the ring (Linux only, via /dev/shm).
+        [[nodiscard]] static auto Discover(std::string_view ring) -> std::vector<std::string>;
+    };
+} // namespace lgx
+
+#ifdef LGX_HEADER_ONLY
+#include "SharedRing.cpp"
+#endif
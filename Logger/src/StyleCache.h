@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Common.h"
+
+namespace lgx {
+    // Caches the ANSI escape sequences fmt renders for a text_style so they are built once instead of per message.
+    // Holds one entry per level default plus a small LRU of custom styles. Not thread-safe, owned by the poll thread.
+    class StyleCache
+    {
+    public:
+        struct Escapes
+        {
+            fmt::text_style style;
+            std::string     prefix;
+            std::string     suffix;
+        };
+
+    public:
+        static constexpr std::size_t MaxCustomStyles = 16;
+
+    private:
+        std::array<std::optional<Escapes>, LevelCount> m_LevelEscapes;
+        std::list<Escapes>                             m_CustomEscapes; // Most recently used first.
+
+    public:
+        // A byte-wise match can only produce false negatives (a re-render), never a wrong escape sequence.
+        [[nodiscard]] static inline auto SameStyle(const fmt::text_style& lhs, const fmt::text_style& rhs) noexcept
+            -> bool
+        {
+            return std::memcmp(&lhs, &rhs, sizeof(fmt::text_style)) == 0;
+        }
+        [[nodiscard]] static inline auto Render(const fmt::text_style& style) -> Escapes
+        {
+            // '|' never appears in an escape sequence, so it cleanly splits what fmt emits around the text.
+            const auto rendered = fmt::format(style, "|");
+            const auto split    = rendered.rfind('|');
+            return Escapes{ .style = style, .prefix = rendered.substr(0, split), .suffix = rendered.substr(split + 1) };
+        }
+
+    public:
+        [[nodiscard]] inline auto Get(const fmt::text_style& style, const Level level,
+                                      const fmt::text_style& levelDefault) -> const Escapes&
+        {
+            if (SameStyle(style, levelDefault))
+            {
+                auto& cached = m_LevelEscapes[static_cast<std::size_t>(level)];
+                if (!cached || !SameStyle(cached->style, levelDefault))
+                    cached = Render(levelDefault);
+                return *cached;
+            }
+
+            for (auto it = m_CustomEscapes.begin(); it != m_CustomEscapes.end(); ++it)
+            {
+                if (SameStyle(it->style, style))
+                {
+                    m_CustomEscapes.splice(m_CustomEscapes.begin(), m_CustomEscapes, it);
+                    return m_CustomEscapes.front();
+                }
+            }
+
+            if (m_CustomEscapes.size() == MaxCustomStyles)
+                m_CustomEscapes.pop_back();
+            m_CustomEscapes.push_front(Render(style));
+            return m_CustomEscapes.front();
+        }
+    };
+} // namespace lgx
@@ -0,0 +1,186 @@
+#include "SyslogSink.h"
+
+#ifdef __unix__
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace lgx {
+    // RFC 5424 severities.
+    [[nodiscard]] LGX_INTERNAL constexpr auto SeverityFromLevel(const Level level) noexcept -> int
+    {
+        switch (level)
+        {
+            using enum Level;
+
+            case Info: return 6;
+            case Warn: return 4;
+            case Error: return 3;
+            case Fatal: return 1;
+            case Debug:
+            case Verbose:
+            default: return 7;
+        }
+    }
+
+    LGX_INLINE SyslogSink::SyslogSink(std::string appName, const Type appType, std::string socketPath)
+        : m_AppName(std::move(appName))
+        , m_SocketPath(std::move(socketPath))
+        , m_Facility(appType == Type::Daemon ? 3 : 1)
+        , m_ProcId(0)
+    {
+        // Header fields must not contain spaces or be empty, "-" is the RFC 5424 nil value.
+        std::replace(m_AppName.begin(), m_AppName.end(), ' ', '_');
+        if (m_AppName.empty())
+            m_AppName = "-";
+
+#ifdef __unix__
+        char hostname[256] = {};
+        if (::gethostname(hostname, sizeof(hostname) - 1) == 0 && hostname[0] != '\0')
+            m_Hostname = hostname;
+        else
+            m_Hostname = "-";
+        m_ProcId = static_cast<int>(::getpid());
+        Connect();
+#else
+        m_Hostname = "-";
+#endif
+        m_Pending.reserve(MaxBatch);
+    }
+
+    LGX_INLINE SyslogSink::~SyslogSink() noexcept
+    {
+        Flush();
+#ifdef __unix__
+        if (m_Socket >= 0)
+            ::close(m_Socket);
+#endif
+    }
+
+    LGX_INLINE auto SyslogSink::Connect() noexcept -> bool
+    {
+#ifdef __unix__
+        if (m_Socket >= 0)
+            ::close(m_Socket);
+
+        m_Socket = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (m_Socket < 0)
+            return false;
+
+        sockaddr_un address = {};
+        address.sun_family  = AF_UNIX;
+        if (m_SocketPath.size() < sizeof(address.sun_path))
+            std::memcpy(address.sun_path, m_SocketPath.c_str(), m_SocketPath.size() + 1);
+
+        if (m_SocketPath.size() >= sizeof(address.sun_path) ||
+            ::connect(m_Socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            ::close(m_Socket);
+            m_Socket = -1;
+            return false;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    LGX_INLINE auto SyslogSink::Append(const Level level, const std::string_view prefix, const std::string_view context,
+                                       const std::string_view message, const std::chrono::system_clock::time_point time)
+        -> void
+    {
+        if (m_PendingCount == MaxBatch)
+            Flush();
+        if (m_PendingCount == m_Pending.size())
+            m_Pending.emplace_back();
+
+        const auto time_obj = std::chrono::system_clock::to_time_t(time);
+        const auto micros   = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()) %
+                            std::chrono::seconds{ 1 };
+
+        // <PRI>VERSION TIMESTAMP HOSTNAME APP-NAME PROCID MSGID STRUCTURED-DATA MSG
+        auto& record = m_Pending[m_PendingCount++];
+        record.clear();
+        fmt::format_to(std::back_inserter(record), "<{}>1 {:%Y-%m-%dT%H:%M:%S}.{:06}Z {} {} {} - - ",
+                       m_Facility * 8 + SeverityFromLevel(level), utils::UtcTime(time_obj), micros.count(),
+                       m_Hostname, m_AppName, m_ProcId);
+        if (!prefix.empty())
+            fmt::format_to(std::back_inserter(record), "[{}] ", prefix);
+        if (!context.empty())
+            fmt::format_to(std::back_inserter(record), "{{{}}} ", context);
+        record.append(message);
+    }
+
+    LGX_INLINE auto SyslogSink::Send(const std::size_t first, const std::size_t count) noexcept -> long
+    {
+#if defined(__linux__)
+        // One syscall for the whole batch, each record is still its own datagram.
+        std::array<mmsghdr, MaxBatch> headers = {};
+        std::array<iovec, MaxBatch>   iov     = {};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            iov[i] = iovec{ .iov_base = m_Pending[first + i].data(), .iov_len = m_Pending[first + i].size() };
+            headers[i].msg_hdr.msg_iov    = &iov[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+        return ::sendmmsg(m_Socket, headers.data(), static_cast<unsigned int>(count), MSG_DONTWAIT | MSG_NOSIGNAL);
+#elif defined(__unix__)
+        (void)count;
+        const auto& record = m_Pending[first];
+        return ::send(m_Socket, record.data(), record.size(), MSG_DONTWAIT) >= 0 ? 1 : -1;
+#else
+        (void)first;
+        (void)count;
+        return -1;
+#endif
+    }
+
+    LGX_INLINE auto SyslogSink::Flush() noexcept -> void
+    {
+#ifdef __unix__
+        std::size_t sent        = 0;
+        bool        reconnected = false;
+        while (sent < m_PendingCount)
+        {
+            if (m_Socket < 0)
+            {
+                if (reconnected)
+                    break;
+                reconnected = true;
+                if (!Connect())
+                    break;
+            }
+
+            const auto result = Send(sent, m_PendingCount - sent);
+            if (result > 0)
+            {
+                sent += static_cast<std::size_t>(result);
+                continue;
+            }
+
+            if (errno == EINTR)
+                continue;
+            if (errno == EMSGSIZE)
+            {
+                // Too large for a datagram, drop just this record.
+                m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                ++sent;
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+                break; // The receiver is backed up, drop the rest of the batch rather than block.
+
+            // The daemon went away (e.g. restarted), reconnect once per flush before giving up on the batch.
+            ::close(m_Socket);
+            m_Socket = -1;
+        }
+        m_Dropped.fetch_add(m_PendingCount - sent, std::memory_order_relaxed);
+#else
+        m_Dropped.fetch_add(m_PendingCount, std::memory_order_relaxed);
+#endif
+        m_PendingCount = 0;
+    }
+} // namespace lgx
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Common.h"
+
+namespace lgx {
+    // Native syslog client speaking RFC 5424 over a non-blocking AF_UNIX datagram socket (/dev/log by default).
+    // Messages are appended to a batch and sent together on Flush(), one datagram each. Nothing ever blocks: when
+    // the receiver's queue is full (EAGAIN) the message is dropped and counted instead. Not thread-safe, it is owned
+    // by a logger's poll thread.
+    class SyslogSink
+    {
+    public:
+        static constexpr std::size_t MaxBatch = 64;
+
+    private:
+        std::string                m_AppName;
+        std::string                m_Hostname;
+        std::string                m_SocketPath;
+        int                        m_Facility;
+        int                        m_ProcId;
+        int                        m_Socket       = -1;
+        std::vector<std::string>   m_Pending; // Recycled, only the first m_PendingCount are queued.
+        std::size_t                m_PendingCount = 0;
+        std::atomic<std::uint64_t> m_Dropped      = 0;
+
+    public:
+        SyslogSink(std::string appName, Type appType, std::string socketPath = "/dev/log");
+        ~SyslogSink() noexcept;
+        SyslogSink(const SyslogSink&)            = delete;
+        SyslogSink& operator=(const SyslogSink&) = delete;
+
+    public:
+        // Number of messages dropped so far because the socket was full or unavailable.
+        [[nodiscard]] inline auto GetDroppedCount() const noexcept -> std::uint64_t
+        {
+            return m_Dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        auto Connect() noexcept -> bool;
+        // Sends m_Pending[first, first + count), returning how many went out or -1 with errno set.
+        auto Send(std::size_t first, std::size_t count) noexcept -> long;
+
+    public:
+        // Formats the message as an RFC 5424 record logged at time, "[prefix] " and "{context} " are prepended when
+        // given.
+        auto Append(Level level, std::string_view prefix, std::string_view context, std::string_view message,
+                    std::chrono::system_clock::time_point time) -> void;
+        auto Flush() noexcept -> void;
+    };
+} // namespace lgx
+
+#ifdef LGX_HEADER_ONLY
+#include "SyslogSink.cpp"
+#endif
@@ -0,0 +1,163 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <ConfigLoader.h>
+
+#include <unistd.h>
+
+// Drives a ConfigLoader against a config file in a temporary directory: a load is applied to registry loggers, a file
+// with any error changes nothing, loggers listing the same file share one stream that is closed once unused, and with
+// Watch() both in-place writes and rename-over replacements are picked up while failed reloads keep the old settings.
+
+namespace fs = std::filesystem;
+
+static bool g_Ok = true;
+
+static auto Check(const bool condition, const std::string_view what) -> void
+{
+    if (!condition)
+    {
+        fmt::print(stderr, "FAIL: {}\n", what);
+        g_Ok = false;
+    }
+}
+
+template <typename TPredicate>
+static auto WaitFor(TPredicate&& predicate) -> bool
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 5 };
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+    }
+    return true;
+}
+
+static auto WriteFile(const fs::path& path, const std::string_view text) -> void
+{
+    std::ofstream file{ path, std::ios::trunc };
+    file << text;
+}
+
+static auto ReadFile(const fs::path& path) -> std::string
+{
+    std::ifstream      file{ path };
+    std::ostringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+// How many of this process's descriptors refer to path, -1 where that cannot be told.
+static auto OpenCount(const fs::path& path) -> int
+{
+#ifdef __linux__
+    int             count = 0;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator{ "/proc/self/fd", error })
+    {
+        if (fs::read_symlink(entry.path(), error) == path)
+            ++count;
+    }
+    return count;
+#else
+    static_cast<void>(path);
+    return -1;
+#endif
+}
+
+auto main() -> int
+{
+    const auto directory = fs::temp_directory_path() / fmt::format("lgx-config-test-{}", ::getpid());
+    fs::create_directories(directory);
+    const auto config = directory / "logex.conf";
+    const auto shared = directory / "shared.log";
+    const auto other  = directory / "other.log";
+
+    std::ostream null_stream{ nullptr };
+    lgx::GetGlobal().SetOutputStreams({ &null_stream }); // Failed reloads are reported there.
+    auto& net = lgx::Get("net");
+    auto& db  = lgx::Get("db");
+    {
+        lgx::ConfigLoader loader{ config };
+
+        // Both loggers write to one file through a single stream.
+        WriteFile(config, fmt::format("# Loggers that are not listed keep their settings.\n"
+                                      "[net]\n"
+                                      "level  = debug\n"
+                                      "format = net {{level}}: {{msg}}\n"
+                                      "sinks  = file:{0}\n"
+                                      "\n"
+                                      "[db]\n"
+                                      "level = warn\n"
+                                      "format = db {{level}}: {{msg}}\n"
+                                      "sinks = file:{0}\n",
+                                      shared.string()));
+        Check(loader.Load(), fmt::format("load failed: {}", loader.GetLastError()));
+        Check(net.GetLevel() == lgx::Debug && db.GetLevel() == lgx::Warn, "levels not applied");
+        Check(net.GetFormat() == "net {level}: {msg}", "format not applied");
+
+        net.Debug("connected");
+        db.Info("not written");
+        db.Warn("slow query");
+        // Each logger has its own poll thread, so the two lines may come in either order.
+        Check(WaitFor(
+                  [&]()
+                  {
+                      const auto text = ReadFile(shared);
+                      return text == "net Debug: connected\ndb Warn: slow query\n" ||
+                             text == "db Warn: slow query\nnet Debug: connected\n";
+                  }),
+              fmt::format("shared.log holds '{}'", ReadFile(shared)));
+        const auto shared_count = OpenCount(shared);
+        Check(shared_count == -1 || shared_count == 1, fmt::format("shared.log open {} times", shared_count));
+
+        // One bad entry anywhere rejects the whole file, the valid ones before it included.
+        for (const auto& invalid : { std::string{ "[net]\nlevel = error\n[db]\nlevel = loud\n" },
+                                     std::string{ "[net]\nlevel = error\nformat = {msg\n" },
+                                     std::string{ "[net]\nlevel = error\nverbosity = 3\n" },
+                                     fmt::format("[net]\nlevel = error\nsinks = file:{}\n",
+                                                 (directory / "missing" / "net.log").string()) })
+        {
+            WriteFile(config, invalid);
+            Check(!loader.Load(), fmt::format("invalid config accepted:\n{}", invalid));
+            Check(!loader.GetLastError().empty(), "no error reported for a rejected config");
+            Check(net.GetLevel() == lgx::Debug, fmt::format("rejected config partially applied:\n{}", invalid));
+        }
+
+        // Moving both loggers to another file closes the one nobody writes to anymore.
+        WriteFile(config, fmt::format("[net]\nsinks = file:{0}\n[db]\nsinks = file:{0}\n", other.string()));
+        Check(loader.Load(), fmt::format("load failed: {}", loader.GetLastError()));
+        Check(OpenCount(shared) <= 0, "shared.log still open after no logger uses it");
+
+        if (loader.Watch())
+        {
+            // Rewritten in place.
+            WriteFile(config, "[net]\nlevel = error\n");
+            Check(WaitFor([&]() { return net.GetLevel() == lgx::Error; }), "in-place write not reloaded");
+
+            // Replaced by renaming a new file over it, as editors and deployment tools do.
+            WriteFile(directory / "logex.conf.new", "[net]\nlevel = info\n");
+            fs::rename(directory / "logex.conf.new", config);
+            Check(WaitFor([&]() { return net.GetLevel() == lgx::Info; }), "rename-over not reloaded");
+
+            // A broken edit is reported and keeps the previous settings.
+            WriteFile(config, "[net]\nlevel = loud\n");
+            Check(WaitFor([&]() { return !loader.GetLastError().empty(); }), "failed reload not reported");
+            Check(net.GetLevel() == lgx::Info, "failed reload changed the level");
+        }
+    }
+
+    // The loader owned the files, its destructor detaches them from the loggers.
+    Check(net.GetOutputStreams().empty() && db.GetOutputStreams().empty(), "file sinks left attached to loggers");
+    Check(OpenCount(other) <= 0, "other.log still open after the loader is gone");
+
+    fs::remove_all(directory);
+    return g_Ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
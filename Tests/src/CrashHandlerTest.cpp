@@ -0,0 +1,137 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Logger.h>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Crashes a child process while its logger is in the middle of writing a batch to a slow stream, with more records
+// queued behind it, and checks that the crash handler dumps every one of them in order.
+
+constexpr int c_Records = 20;
+
+static std::atomic<bool> g_WriteStarted = false;
+
+// Stands in for a congested disk or pipe: each flushed line takes a while before it reaches the fd.
+class SlowBuffer : public std::streambuf
+{
+private:
+    int         m_Fd;
+    std::string m_Line;
+
+public:
+    explicit SlowBuffer(const int fd)
+        : m_Fd(fd)
+    {
+    }
+
+protected:
+    auto overflow(const int_type c) -> int_type override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+            m_Line.push_back(traits_type::to_char_type(c));
+        return traits_type::not_eof(c);
+    }
+    auto sync() -> int override
+    {
+        g_WriteStarted = true;
+        std::this_thread::sleep_for(std::chrono::seconds{ 2 });
+        const auto written = ::write(m_Fd, m_Line.data(), m_Line.size());
+        m_Line.clear();
+        return written < 0 ? -1 : 0;
+    }
+};
+
+[[noreturn]] static auto RunChild(const std::string& crashPath, const std::string& outputPath) -> void
+{
+    const int crash_fd  = ::open(crashPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    const int output_fd = ::open(outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (crash_fd < 0 || output_fd < 0 || !lgx::InstallCrashHandler(crash_fd))
+        std::_Exit(2);
+
+    SlowBuffer   buffer{ output_fd };
+    std::ostream slow{ &buffer };
+    const auto   logger = lgx::Logger{ lgx::Logger::Properties{
+          .outputStreams = { &slow }, .defaultPrefix = "Child", .defaultStyle = { .format = "{msg}" } } };
+
+    // The first record is taken off the queue and stuck in the slow write, the rest queue up behind it.
+    logger.Info("record {}", 0);
+    while (!g_WriteStarted)
+        std::this_thread::yield();
+    for (int i = 1; i < c_Records; ++i)
+        logger.Info("record {}", i);
+
+    std::abort();
+}
+
+static auto ReadLines(const std::string& path) -> std::vector<std::string>
+{
+    std::vector<std::string> lines;
+    std::ifstream            file{ path };
+    for (std::string line; std::getline(file, line);)
+        lines.push_back(line);
+    return lines;
+}
+
+auto main() -> int
+{
+    const auto directory   = std::filesystem::temp_directory_path();
+    const auto crash_path  = (directory / fmt::format("lgx-crash-test-{}.crash", ::getpid())).string();
+    const auto output_path = (directory / fmt::format("lgx-crash-test-{}.out", ::getpid())).string();
+
+    const pid_t child = ::fork();
+    if (child < 0)
+    {
+        fmt::print(stderr, "fork failed\n");
+        return EXIT_FAILURE;
+    }
+    if (child == 0)
+        RunChild(crash_path, output_path);
+
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    const auto dumped  = ReadLines(crash_path);
+    const auto written = ReadLines(output_path);
+    std::filesystem::remove(crash_path);
+    std::filesystem::remove(output_path);
+
+    bool ok = true;
+    if (!WIFSIGNALED(status) || WTERMSIG(status) != SIGABRT)
+    {
+        fmt::print(stderr, "FAIL: child did not die from SIGABRT (status {})\n", status);
+        ok = false;
+    }
+    if (!written.empty())
+    {
+        fmt::print(stderr, "FAIL: {} records reached the slow stream before the crash, expected none\n",
+                   written.size());
+        ok = false;
+    }
+    if (dumped.size() != c_Records)
+    {
+        fmt::print(stderr, "FAIL: crash fd received {} lines, expected {}\n", dumped.size(), c_Records);
+        ok = false;
+    }
+    for (std::size_t i = 0; i < dumped.size() && i < c_Records; ++i)
+    {
+        const auto expected = fmt::format("[Info] (Child): record {}", i);
+        if (dumped[i] != expected)
+        {
+            fmt::print(stderr, "FAIL: line {} is '{}', expected '{}'\n", i, dumped[i], expected);
+            ok = false;
+        }
+    }
+
+    if (ok)
+        fmt::print("crash dump: {} of {} unwritten records recovered\n", dumped.size(), c_Records);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,58 @@
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <Logger.h>
+
+// Unusable recorder formats have to be rejected up front: a dump runs on the logger's poll thread, where a
+// fmt::format_error would take the process down. Usable ones render every placeholder a logger format has.
+
+static bool g_Ok = true;
+
+static auto Check(const bool condition, const std::string_view what) -> void
+{
+    if (!condition)
+    {
+        fmt::print(stderr, "FAIL: {}\n", what);
+        g_Ok = false;
+    }
+}
+
+static auto IsRejected(lgx::FlightRecorder::Properties properties) -> bool
+{
+    try
+    {
+        lgx::FlightRecorder recorder{ std::move(properties) };
+        return false;
+    }
+    catch (const std::invalid_argument&)
+    {
+        return true;
+    }
+}
+
+auto main() -> int
+{
+    for (const char* format : { "{ctx}: {msg}", "{msg", "{level:d} {msg}" })
+        Check(IsRejected({ .format = format }), fmt::format("format '{}' accepted", format));
+    for (const char* format : { "%Q", "%" })
+        Check(IsRejected({ .dateTimeFormat = format }), fmt::format("date time format '{}' accepted", format));
+
+    std::ostringstream dump;
+    auto               recorder = lgx::FlightRecorder{ {
+        .maxRecords = 8, .dumpStream = &dump, .format = "[{level}] ({prefix}) {context} x{sample_rate}: {msg}" } };
+    {
+        const auto logger = lgx::Logger{ lgx::Logger::Properties{
+            .outputStreams = {}, .defaultPrefix = "Rec", .flightRecorder = &recorder } };
+        lgx::ScopedContext context{ "req", 7 };
+        logger.Verbose("opening");
+        logger.Error("refused");
+    }
+
+    const auto expected = std::string{ "[Verbose] (Rec) req=7 x1: opening\n[Error] (Rec) req=7 x1: refused\n" };
+    Check(dump.str() == expected, fmt::format("dumped '{}', expected '{}'", dump.str(), expected));
+    Check(recorder.GetRecordCount() == 0, "records left after the dump");
+
+    return g_Ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
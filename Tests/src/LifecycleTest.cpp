@@ -0,0 +1,124 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <Logger.h>
+
+// Moving and swapping loggers hands queued records from one poll thread to another, none of them may be left behind
+// and handing them over must not wait for producers to go quiet.
+
+static bool g_Ok = true;
+
+static auto Check(const bool condition, const std::string_view what) -> void
+{
+    if (!condition)
+    {
+        fmt::print(stderr, "FAIL: {}\n", what);
+        g_Ok = false;
+    }
+}
+
+// Counts the lines written to it, readable while a poll thread is writing (std::endl syncs once per line).
+// A delay makes it a slow sink.
+class LineCounter : public std::stringbuf
+{
+private:
+    std::chrono::microseconds m_Delay;
+    std::atomic<long>         m_Lines = 0;
+
+public:
+    explicit LineCounter(const std::chrono::microseconds delay = {})
+        : m_Delay(delay)
+    {
+    }
+
+public:
+    [[nodiscard]] auto GetLines() const noexcept -> long { return m_Lines.load(); }
+
+protected:
+    auto sync() -> int override
+    {
+        if (m_Delay.count() > 0)
+            std::this_thread::sleep_for(m_Delay);
+        ++m_Lines;
+        return 0;
+    }
+};
+
+static auto MakeProperties(std::ostream& out) -> lgx::Logger::Properties
+{
+    return lgx::Logger::Properties{ .outputStreams = { &out }, .defaultStyle = { .format = "{msg}" } };
+}
+
+// Records swapped into a logger whose poll thread is idle have to be written without waiting for another Log().
+static auto TestSwapWakesPollThreads() -> void
+{
+    LineCounter  lines;
+    std::ostream out{ &lines };
+
+    // A moved-from logger has no poll thread, so records logged to it stay queued until the swap.
+    auto       queued = lgx::Logger{ MakeProperties(out) };
+    const auto keeper = lgx::Logger{ std::move(queued) };
+    queued.UpdateProperties([&](auto& properties) { properties = MakeProperties(out); });
+
+    auto idle = lgx::Logger{ MakeProperties(out) };
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+    for (int i = 0; i < 5; ++i)
+        queued.Info("swapped {}", i);
+    queued.Swap(idle);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 2 };
+    while (lines.GetLines() < 5 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+    Check(lines.GetLines() == 5, fmt::format("{} of 5 swapped records written", lines.GetLines()));
+}
+
+// Move-assigning over a logger whose sink is slower than its producers must not wait for them to stop, and every
+// record still has to come out exactly once, through the old sink or the new one.
+static auto TestMoveAssignDoesNotWaitForProducers() -> void
+{
+    LineCounter  slow_lines{ std::chrono::microseconds{ 200 } };
+    LineCounter  fast_lines;
+    std::ostream slow{ &slow_lines };
+    std::ostream fast{ &fast_lines };
+
+    auto              target = lgx::Logger{ MakeProperties(slow) };
+    std::atomic<long> sent   = 0;
+    std::thread       producer(
+        [&]()
+        {
+            const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds{ 1500 };
+            while (std::chrono::steady_clock::now() < end)
+            {
+                target.Info("record {}", sent.load());
+                ++sent;
+                std::this_thread::sleep_for(std::chrono::microseconds{ 100 });
+            }
+        });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 100 });
+    const auto start = std::chrono::steady_clock::now();
+    target           = lgx::Logger{ MakeProperties(fast) };
+    const auto took  = std::chrono::steady_clock::now() - start;
+    producer.join();
+    {
+        // Stops target's poll thread, writing what is still queued.
+        const auto drained = std::move(target);
+    }
+
+    Check(took < std::chrono::milliseconds{ 750 },
+          fmt::format("move-assign took {} ms while the producer was running",
+                      std::chrono::duration_cast<std::chrono::milliseconds>(took).count()));
+    Check(slow_lines.GetLines() + fast_lines.GetLines() == sent,
+          fmt::format("{} + {} records written, {} sent", slow_lines.GetLines(), fast_lines.GetLines(), sent.load()));
+}
+
+auto main() -> int
+{
+    TestSwapWakesPollThreads();
+    TestMoveAssignDoesNotWaitForProducers();
+    return g_Ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,121 @@
+#include <atomic>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <Logger.h>
+
+// Hammers one registry logger from several producers while other threads change its settings, add loggers to the
+// registry and move-assign fresh loggers over it. Every record must come out exactly once and in order per producer.
+// Build with -DLGX_ENABLE_TSAN=ON to run it under ThreadSanitizer.
+
+constexpr int c_Producers = 4;
+constexpr int c_Records   = 2000; // Per producer.
+
+auto main() -> int
+{
+    std::ostringstream capture; // Only written by whichever poll thread currently owns the "stress" logger.
+    std::ostream       null_stream{ nullptr };
+
+    const auto make = [&]()
+    {
+        return lgx::Logger{ lgx::Logger::Properties{ .outputStreams = { &capture },
+                                                     .defaultStyle  = { .format = "{msg}" } } };
+    };
+    lgx::Get("stress") = make();
+    lgx::GetGlobal().SetOutputStreams({ &null_stream });
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < c_Producers; ++t)
+    {
+        producers.emplace_back(
+            [&, t]()
+            {
+                for (int i = 0; i < c_Records; ++i)
+                {
+                    if (i % 3 == 0)
+                        lgx::Get("stress").Log(lgx::Info, "{} {}", t, i);
+                    else if (i % 3 == 1)
+                        lgx::Get("stress").Log("Producer", lgx::Warn, "{} {}", t, i);
+                    else
+                        lgx::Get("stress").LogSampled(lgx::Error, "{} {}", t, i);
+                }
+            });
+    }
+
+    std::atomic<bool> done = false;
+    std::thread       setter(
+        [&]()
+        {
+            for (int k = 0; !done; ++k)
+            {
+                auto& logger = lgx::Get("stress");
+                logger.SetVerbose(k & 1);
+                logger.SetDefaultPrefix(k & 1 ? "A" : "B");
+                logger.SetDefaultInfoStyle(fmt::fg(fmt::color::red));
+                logger.SetDateTimeFormat("%H");
+                logger.SetSampleRate(lgx::Verbose, 3);
+                (void)logger.GetOutputStreams();
+                (void)logger.GetFormat();
+                lgx::Log(lgx::Info, "global {}", k);
+            }
+        });
+    std::thread registry(
+        [&]()
+        {
+            for (int i = 0; i < 40; ++i)
+            {
+                auto& logger = lgx::Get(fmt::format("new-{}", i));
+                logger.SetOutputStreams({ &null_stream });
+                lgx::ScopedContext context{ "i", i };
+                logger.Info("registered");
+            }
+        });
+    std::thread mover(
+        [&]()
+        {
+            for (int i = 0; i < 15; ++i)
+            {
+                lgx::Get("stress") = make();
+                std::this_thread::sleep_for(std::chrono::milliseconds{ 2 });
+            }
+        });
+
+    for (auto& producer : producers)
+        producer.join();
+    done = true;
+    setter.join();
+    registry.join();
+    mover.join();
+
+    // Drains what is still queued into capture before reading it.
+    lgx::Get("stress") = make();
+
+    std::istringstream lines{ capture.str() };
+    std::vector<int>   next(c_Producers, 0);
+    long               count      = 0;
+    long               violations = 0;
+    int                producer   = 0;
+    int                record     = 0;
+    while (lines >> producer >> record)
+    {
+        ++count;
+        if (producer < 0 || producer >= c_Producers)
+        {
+            ++violations;
+            continue;
+        }
+        if (next[producer] != record)
+            ++violations;
+        next[producer] = record + 1;
+    }
+
+    const long expected = static_cast<long>(c_Producers) * c_Records;
+    if (count != expected || violations != 0)
+    {
+        fmt::print(stderr, "FAIL: {} of {} records written, {} out of order\n", count, expected, violations);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
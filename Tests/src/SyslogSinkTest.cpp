@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <regex>
+#include <string>
+#include <thread>
+
+#include <Logger.h>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Points a logger's syslog sink at a local AF_UNIX datagram listener standing in for /dev/log. Checks the RFC 5424
+// framing of a record, then floods the listener without reading it and checks that every record either arrives or
+// is counted as dropped.
+
+constexpr int c_FloodRecords = 2000;
+
+static bool g_Ok = true;
+
+static auto Check(const bool condition, const std::string_view what) -> void
+{
+    if (!condition)
+    {
+        fmt::print(stderr, "FAIL: {}\n", what);
+        g_Ok = false;
+    }
+}
+
+// Waits up to timeout for a datagram, returns an empty string if none arrived.
+static auto Receive(const int fd, const std::chrono::milliseconds timeout) -> std::string
+{
+    pollfd entry = { fd, POLLIN, 0 };
+    if (::poll(&entry, 1, static_cast<int>(timeout.count())) <= 0)
+        return {};
+
+    char       buffer[4096];
+    const auto size = ::recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    return size > 0 ? std::string(buffer, static_cast<std::size_t>(size)) : std::string{};
+}
+
+auto main() -> int
+{
+    const auto path = (std::filesystem::temp_directory_path() / fmt::format("lgx-syslog-test-{}.sock", ::getpid()))
+                          .string();
+
+    const int listener = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address = {};
+    address.sun_family  = AF_UNIX;
+    if (listener < 0 || path.size() >= sizeof(address.sun_path))
+    {
+        fmt::print(stderr, "cannot create a listener at {}\n", path);
+        return EXIT_FAILURE;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        fmt::print(stderr, "cannot bind {}\n", path);
+        return EXIT_FAILURE;
+    }
+
+    {
+        const auto logger = lgx::Logger{ lgx::Logger::Properties{ .loggerName       = "Syslog Test",
+                                                                  .appType          = lgx::Type::Daemon,
+                                                                  .outputStreams    = {},
+                                                                  .syslog           = true,
+                                                                  .defaultStyle     = { .format = "{prefix} {msg}" },
+                                                                  .syslogSocketPath = path } };
+
+        // <PRI>VERSION TIMESTAMP HOSTNAME APP-NAME PROCID MSGID STRUCTURED-DATA MSG, daemon facility (3) and
+        // warning severity (4) give PRI 28. Prefix and context are only sent when the format has them.
+        {
+            lgx::ScopedContext context{ "req", 7 };
+            logger.Log("Net", lgx::Warn, "hello {}", 1);
+        }
+        const auto record = Receive(listener, std::chrono::seconds{ 5 });
+
+        char hostname[256] = {};
+        ::gethostname(hostname, sizeof(hostname) - 1);
+        const auto expected_tail = fmt::format(" {} Syslog_Test {} - - [Net] hello 1", hostname, ::getpid());
+        const auto header        = std::regex{ R"(^<28>1 \d{4}-\d\d-\d\dT\d\d:\d\d:\d\d\.\d{6}Z )" };
+
+        Check(!record.empty(), "no datagram received");
+        Check(std::regex_search(record, header), fmt::format("bad header in '{}'", record));
+        Check(record.ends_with(expected_tail), fmt::format("'{}' does not end with '{}'", record, expected_tail));
+
+        // Nothing reads the socket meanwhile, so its queue fills up and the sink has to drop instead of blocking.
+        for (int i = 0; i < c_FloodRecords; ++i)
+            logger.Info("flood {}", i);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 200 });
+        std::uint64_t received = 0;
+        const auto    deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 10 };
+        while (received + logger.GetSyslogDropCount() < c_FloodRecords && std::chrono::steady_clock::now() < deadline)
+        {
+            if (!Receive(listener, std::chrono::milliseconds{ 100 }).empty())
+                ++received;
+        }
+        const auto dropped = logger.GetSyslogDropCount();
+        Check(received + dropped == c_FloodRecords,
+              fmt::format("received {} + dropped {} != sent {}", received, dropped, c_FloodRecords));
+
+        if (g_Ok)
+            fmt::print("syslog: {} received, {} dropped of {} sent\n", received, dropped, c_FloodRecords);
+    }
+
+    ::close(listener);
+    std::filesystem::remove(path);
+    return g_Ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
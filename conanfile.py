@@ -9,7 +9,7 @@ class MyLibConan(ConanFile):
     options = {"shared": [True, False]}
     default_options = {"shared": False}
 
-    exports_sources = "Logger/CMakeLists.txt", "Logger/src/*", "Logger/include/*"
+    exports_sources = "Logger/CMakeLists.txt", "Logger/cmake/*", "Logger/src/*"
     generators = "CMakeDeps", "CMakeToolchain"
 
     def layout(self):
@@ -25,6 +25,6 @@ class MyLibConan(ConanFile):
         cmake.install()
 
     def package_info(self):
-        self.cpp_info.set_property("cmake_target_name", "logex::Logex")
-        self.cpp_info.libs = ["Logex"]
+        self.cpp_info.set_property("cmake_target_name", "logex::logex")
+        self.cpp_info.libs = ["logex-static"]
 